@@ -12,10 +12,12 @@
 
 static ID id_bind_type;
 static ID id_charset_form;
+static ID id_owner;
 static VALUE sym_length;
 static VALUE sym_length_semantics;
 static VALUE sym_char;
 static VALUE sym_nchar;
+static VALUE sym_max_size;
 
 static VALUE cOCI8BindTypeBase;
 
@@ -24,6 +26,7 @@ typedef struct {
     sb4 bytelen;
     sb4 charlen;
     ub1 csfrm;
+    ub1 intern_strings;
 } oci8_bind_string_t;
 
 static ub4 initial_chunk_size = 32 * 1024;
@@ -40,11 +43,40 @@ typedef struct {
     chunk_t *head;
     chunk_t **tail;
     chunk_t **inpos;
+    int overflow; /* set when a fetched value exceeds max_size */
 } chunk_buf_t;
 
+/*
+ * Process-wide pool of chunks released by LONG and LONG RAW binds.
+ * Chunks are classified by their alloc_len. It is shared by all
+ * define and bind handles and may be accessed without the GVL in
+ * define_callback() and out_bind_callback().
+ */
+#define CHUNK_POOL_CLASSES 16
+
+typedef struct {
+    ub4 alloc_len;
+    chunk_t *head;
+} chunk_pool_class_t;
+
+static chunk_pool_class_t chunk_pool[CHUNK_POOL_CLASSES];
+static size_t chunk_pool_bytes = 0;
+static size_t chunk_pool_max_bytes = 32 * 1024 * 1024;
+
+#ifdef _WIN32
+static CRITICAL_SECTION chunk_pool_lock;
+#define CHUNK_POOL_LOCK() EnterCriticalSection(&chunk_pool_lock)
+#define CHUNK_POOL_UNLOCK() LeaveCriticalSection(&chunk_pool_lock)
+#else
+static pthread_mutex_t chunk_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+#define CHUNK_POOL_LOCK() pthread_mutex_lock(&chunk_pool_lock)
+#define CHUNK_POOL_UNLOCK() pthread_mutex_unlock(&chunk_pool_lock)
+#endif
+
 typedef struct {
     oci8_bind_t obind;
     ub1 csfrm;
+    ub4 max_size; /* maximum size of fetched values in bytes. 0 means unlimited. */
 } oci8_bind_long_t;
 
 #define IS_BIND_LONG(obind) (((oci8_bind_data_type_t*)obind->base.data_type)->dty == SQLT_CHR)
@@ -69,12 +101,55 @@ const oci8_handle_data_type_t oci8_bind_data_type = {
 /*
  * bind_string
  */
+
+/*
+ * Creates a frozen and deduplicated string.
+ * When the string isn't converted to Encoding.default_internal,
+ * it is created directly from the buffer and the bytes are copied
+ * only when the same string doesn't exist.
+ */
+static VALUE interned_str_new(const char *ptr, long len)
+{
+#ifdef HAVE_RB_ENC_INTERNED_STR
+    rb_encoding *enc = rb_default_internal_encoding();
+    VALUE str;
+
+    if (enc == NULL || enc == oci8_encoding) {
+        return rb_enc_interned_str(ptr, len, oci8_encoding);
+    }
+    str = rb_external_str_new_with_enc(ptr, len, oci8_encoding);
+    return rb_enc_interned_str(RSTRING_PTR(str), RSTRING_LEN(str), rb_enc_get(str));
+#else
+    return rb_obj_freeze(rb_external_str_new_with_enc(ptr, len, oci8_encoding));
+#endif
+}
+
 static VALUE bind_string_get(oci8_bind_t *obind, void *data, void *null_struct)
 {
+    oci8_bind_string_t *obs = (oci8_bind_string_t *)obind;
     oci8_vstr_t *vstr = (oci8_vstr_t *)data;
+
+    if (obs->intern_strings) {
+        return interned_str_new(vstr->buf, vstr->size);
+    }
     return rb_external_str_new_with_enc(vstr->buf, vstr->size, oci8_encoding);
 }
 
+/*
+ * @overload intern_strings=(val)
+ *
+ *  When +val+ is true, fetched strings are frozen and deduplicated.
+ *
+ *  @private
+ */
+static VALUE bind_string_set_intern_strings(VALUE self, VALUE val)
+{
+    oci8_bind_string_t *obs = (oci8_bind_string_t *)TO_BIND(self);
+
+    obs->intern_strings = RTEST(val) ? 1 : 0;
+    return val;
+}
+
 static void bind_string_set(oci8_bind_t *obind, void *data, void **null_structp, VALUE val)
 {
     oci8_bind_string_t *obs = (oci8_bind_string_t *)obind;
@@ -333,6 +408,62 @@ static VALUE bind_boolean_alloc(VALUE klass)
 /*
  * bind_long
  */
+
+/* Takes a chunk whose size is alloc_len from the pool. */
+static chunk_t *chunk_pool_get(ub4 alloc_len)
+{
+    chunk_t *chunk = NULL;
+    int i;
+
+    CHUNK_POOL_LOCK();
+    for (i = 0; i < CHUNK_POOL_CLASSES; i++) {
+        if (chunk_pool[i].alloc_len == alloc_len) {
+            chunk = chunk_pool[i].head;
+            if (chunk != NULL) {
+                chunk_pool[i].head = chunk->next;
+                chunk_pool_bytes -= alloc_len;
+            }
+            break;
+        }
+    }
+    CHUNK_POOL_UNLOCK();
+    return chunk;
+}
+
+/* Returns a chunk to the pool. It is freed when the pool is full. */
+static void chunk_pool_put(chunk_t *chunk)
+{
+    int i;
+    int empty = -1;
+
+    CHUNK_POOL_LOCK();
+    if (chunk_pool_bytes + chunk->alloc_len <= chunk_pool_max_bytes) {
+        for (i = 0; i < CHUNK_POOL_CLASSES; i++) {
+            if (chunk_pool[i].alloc_len == chunk->alloc_len) {
+                break;
+            }
+            if (empty == -1 && chunk_pool[i].head == NULL) {
+                empty = i;
+            }
+        }
+        if (i == CHUNK_POOL_CLASSES) {
+            /* use an empty class for a new size. */
+            i = empty;
+        }
+        if (i != -1) {
+            chunk_pool[i].alloc_len = chunk->alloc_len;
+            chunk->next = chunk_pool[i].head;
+            chunk_pool[i].head = chunk;
+            chunk_pool_bytes += chunk->alloc_len;
+            chunk = NULL;
+        }
+    }
+    CHUNK_POOL_UNLOCK();
+    if (chunk != NULL) {
+        xfree(chunk);
+    }
+}
+
 static chunk_t *next_chunk(chunk_buf_t *cb)
 {
    chunk_t *chunk;
@@ -349,23 +480,47 @@ static chunk_t *next_chunk(chunk_buf_t *cb)
                alloc_len = max_chunk_size;
            }
        }
-       chunk = xmalloc(offsetof(chunk_t, buf) + alloc_len);
+       chunk = chunk_pool_get(alloc_len);
+       if (chunk == NULL) {
+           chunk = xmalloc(offsetof(chunk_t, buf) + alloc_len);
+           chunk->alloc_len = alloc_len;
+       }
        chunk->next = NULL;
-       chunk->alloc_len = alloc_len;
        *cb->tail = chunk;
    }
    cb->tail = &chunk->next;
    return chunk;
 }
 
+static size_t chunk_buf_len(chunk_buf_t *cb)
+{
+    chunk_t *chunk;
+    size_t len = 0;
+
+    for (chunk = cb->head; chunk != *cb->tail; chunk = chunk->next) {
+        len += chunk->used_len;
+    }
+    return len;
+}
+
 static sb4 define_callback(void *octxp, OCIDefine *defnp, ub4 iter, void **bufpp, ub4 **alenp, ub1 *piecep, void **indp, ub2 **rcodep)
 {
     oci8_bind_t *obind = (oci8_bind_t *)octxp;
+    ub4 max_size = ((oci8_bind_long_t *)obind)->max_size;
     chunk_buf_t *cb = ((chunk_buf_t*)obind->valuep) + iter;
     chunk_t *chunk;
 
     if (*piecep == OCI_FIRST_PIECE) {
         cb->tail = &cb->head;
+        cb->overflow = 0;
+    } else if (max_size != 0) {
+        if (!cb->overflow && chunk_buf_len(cb) > max_size) {
+            cb->overflow = 1;
+        }
+        if (cb->overflow) {
+            /* discard the rest of the value by overwriting the first chunk. */
+            cb->tail = &cb->head;
+        }
     }
     chunk = next_chunk(cb);
     chunk->used_len = chunk->alloc_len;
@@ -437,7 +592,7 @@ static void bind_long_free(oci8_base_t *base)
             chunk_t *chunk, *chunk_next;
             for (chunk = cb[idx].head; chunk != NULL; chunk = chunk_next) {
                 chunk_next = chunk->next;
-                xfree(chunk);
+                chunk_pool_put(chunk);
             }
         } while (++idx < obind->maxar_sz);
     }
@@ -446,22 +601,34 @@ static void bind_long_free(oci8_base_t *base)
 
 static VALUE bind_long_get(oci8_bind_t *obind, void *data, void *null_struct)
 {
+    ub4 max_size = ((oci8_bind_long_t *)obind)->max_size;
     chunk_buf_t *cb = (chunk_buf_t *)data;
     chunk_t *chunk;
     long len = 0;
     VALUE str;
     char *buf;
 
-    for (chunk = cb->head; chunk != *cb->tail; chunk = chunk->next) {
-        len += chunk->used_len;
+    if (max_size != 0 && (cb->overflow || chunk_buf_len(cb) > max_size)) {
+        rb_raise(rb_eRuntimeError, "fetched value exceeds the maximum size (%u bytes)", max_size);
     }
-    str = rb_str_buf_new(len);
-    buf = RSTRING_PTR(str);
-    for (chunk = cb->head; chunk != *cb->tail; chunk = chunk->next) {
-        memcpy(buf, chunk->buf, chunk->used_len);
-        buf += chunk->used_len;
+    if (cb->tail == &cb->head) {
+        /* empty */
+        str = rb_str_new(NULL, 0);
+    } else if (cb->tail == &cb->head->next) {
+        /* The value fits in a chunk. */
+        str = rb_str_new(cb->head->buf, cb->head->used_len);
+    } else {
+        for (chunk = cb->head; chunk != *cb->tail; chunk = chunk->next) {
+            len += chunk->used_len;
+        }
+        str = rb_str_buf_new(len);
+        buf = RSTRING_PTR(str);
+        for (chunk = cb->head; chunk != *cb->tail; chunk = chunk->next) {
+            memcpy(buf, chunk->buf, chunk->used_len);
+            buf += chunk->used_len;
+        }
+        rb_str_set_len(str, len);
     }
-    rb_str_set_len(str, len);
     if (IS_BIND_LONG(obind)) {
         rb_encoding *enc = rb_default_internal_encoding();
 
@@ -503,8 +670,9 @@ static void bind_long_set(oci8_bind_t *obind, void *data, void **null_structp, V
 
 static void bind_long_init(oci8_bind_t *obind, VALUE svc, VALUE val, VALUE param)
 {
+    oci8_bind_long_t *obl = (oci8_bind_long_t *)obind;
+
     if (IS_BIND_LONG(obind)) {
-        oci8_bind_long_t *obl = (oci8_bind_long_t *)obind;
         VALUE nchar;
 
         if (rb_respond_to(param, id_charset_form)) {
@@ -521,6 +689,12 @@ static void bind_long_init(oci8_bind_t *obind, VALUE svc, VALUE val, VALUE param
             obl->csfrm = SQLCS_IMPLICIT; /* bind as CHAR/VARCHAR2 */
         }
     }
+    if (TYPE(param) == T_HASH) {
+        VALUE max_size = rb_hash_aref(param, sym_max_size);
+        if (!NIL_P(max_size)) {
+            obl->max_size = NUM2UINT(max_size);
+        }
+    }
     obind->value_sz = SB4MAXVAL;
     obind->alloc_sz = sizeof(chunk_buf_t);
 }
@@ -619,11 +793,14 @@ static VALUE bind_long_raw_alloc(VALUE klass)
     return oci8_allocate_typeddata(klass, &bind_long_raw_data_type.base);
 }
 
-static VALUE oci8_bind_get(VALUE self)
+/* values of oci8_bind_t.get_type and set_type */
+#define GET_TYPE_UNKNOWN 0 /* not checked yet */
+#define GET_TYPE_NATIVE  1 /* OCI8::BindType::Base#get (or #set) */
+#define GET_TYPE_RUBY    2 /* overridden in ruby */
+
+static inline VALUE bind_get_native(oci8_bind_t *obind, ub4 idx)
 {
-    oci8_bind_t *obind = TO_BIND(self);
     const oci8_bind_data_type_t *data_type = (const oci8_bind_data_type_t *)obind->base.data_type;
-    ub4 idx = obind->curar_idx;
     void **null_structp = NULL;
 
     if (NIL_P(obind->tdo)) {
@@ -633,6 +810,37 @@ static VALUE oci8_bind_get(VALUE self)
     return data_type->get(obind, (void*)((size_t)obind->valuep + obind->alloc_sz * idx), null_structp);
 }
 
+/*
+ * Gets the idx-th value of the bind object.
+ *
+ * The C function in the virtual method table is called directly
+ * when 'get' isn't overridden in ruby. Otherwise, the ruby method
+ * is called as OCI8::BindType::Base#get_data does.
+ */
+VALUE oci8_bind_get_at(oci8_bind_t *obind, ub4 idx)
+{
+    obind->curar_idx = idx;
+    if (UNLIKELY(obind->get_type == GET_TYPE_UNKNOWN)) {
+        VALUE method = rb_obj_method(obind->base.self, ID2SYM(oci8_id_get));
+        if (rb_funcall(method, id_owner, 0) == cOCI8BindTypeBase) {
+            obind->get_type = GET_TYPE_NATIVE;
+        } else {
+            obind->get_type = GET_TYPE_RUBY;
+        }
+    }
+    if (LIKELY(obind->get_type == GET_TYPE_NATIVE)) {
+        return bind_get_native(obind, idx);
+    }
+    return rb_funcall(obind->base.self, oci8_id_get, 0);
+}
+
+static VALUE oci8_bind_get(VALUE self)
+{
+    oci8_bind_t *obind = TO_BIND(self);
+
+    return bind_get_native(obind, obind->curar_idx);
+}
+
 static VALUE oci8_bind_get_data(int argc, VALUE *argv, VALUE self)
 {
     oci8_bind_t *obind = TO_BIND(self);
@@ -644,28 +852,23 @@ static VALUE oci8_bind_get_data(int argc, VALUE *argv, VALUE self)
         if (idx >= obind->maxar_sz) {
             rb_raise(rb_eRuntimeError, "data index is too big. (%u for %u)", idx, obind->maxar_sz);
         }
-        obind->curar_idx = idx;
-        return rb_funcall(self, oci8_id_get, 0);
+        return oci8_bind_get_at(obind, idx);
     } else if (obind->maxar_sz == 0) {
-        obind->curar_idx = 0;
-        return rb_funcall(self, oci8_id_get, 0);
+        return oci8_bind_get_at(obind, 0);
     } else {
         volatile VALUE ary = rb_ary_new2(obind->curar_sz);
         ub4 idx;
 
         for (idx = 0; idx < obind->curar_sz; idx++) {
-            obind->curar_idx = idx;
-            rb_ary_store(ary, idx, rb_funcall(self, oci8_id_get, 0));
+            rb_ary_store(ary, idx, oci8_bind_get_at(obind, idx));
         }
         return ary;
     }
 }
 
-static VALUE oci8_bind_set(VALUE self, VALUE val)
+static inline void bind_set_native(oci8_bind_t *obind, ub4 idx, VALUE val)
 {
-    oci8_bind_t *obind = TO_BIND(self);
     const oci8_bind_data_type_t *data_type = (const oci8_bind_data_type_t *)obind->base.data_type;
-    ub4 idx = obind->curar_idx;
 
     if (NIL_P(val)) {
         if (NIL_P(obind->tdo)) {
@@ -685,6 +888,35 @@ static VALUE oci8_bind_set(VALUE self, VALUE val)
         }
         data_type->set(obind, (void*)((size_t)obind->valuep + obind->alloc_sz * idx), null_structp, val);
     }
+}
+
+/*
+ * Sets the idx-th element. This calls the set function of the data
+ * type directly unless 'set' is overridden in ruby.
+ */
+void oci8_bind_set_at(oci8_bind_t *obind, ub4 idx, VALUE val)
+{
+    obind->curar_idx = idx;
+    if (UNLIKELY(obind->set_type == GET_TYPE_UNKNOWN)) {
+        VALUE method = rb_obj_method(obind->base.self, ID2SYM(oci8_id_set));
+        if (rb_funcall(method, id_owner, 0) == cOCI8BindTypeBase) {
+            obind->set_type = GET_TYPE_NATIVE;
+        } else {
+            obind->set_type = GET_TYPE_RUBY;
+        }
+    }
+    if (LIKELY(obind->set_type == GET_TYPE_NATIVE)) {
+        bind_set_native(obind, idx, val);
+    } else {
+        rb_funcall(obind->base.self, oci8_id_set, 1, val);
+    }
+}
+
+static VALUE oci8_bind_set(VALUE self, VALUE val)
+{
+    oci8_bind_t *obind = TO_BIND(self);
+
+    bind_set_native(obind, obind->curar_idx, val);
     return self;
 }
 
@@ -693,8 +925,7 @@ static VALUE oci8_bind_set_data(VALUE self, VALUE val)
     oci8_bind_t *obind = TO_BIND(self);
 
     if (obind->maxar_sz == 0) {
-        obind->curar_idx = 0;
-        rb_funcall(self, oci8_id_set, 1, val);
+        oci8_bind_set_at(obind, 0, val);
     } else {
         ub4 size;
         ub4 idx;
@@ -705,8 +936,7 @@ static VALUE oci8_bind_set_data(VALUE self, VALUE val)
             rb_raise(rb_eRuntimeError, "over the max array size");
         }
         for (idx = 0; idx < size; idx++) {
-            obind->curar_idx = idx;
-            rb_funcall(self, oci8_id_set, 1, RARRAY_AREF(val, idx));
+            oci8_bind_set_at(obind, idx, RARRAY_AREF(val, idx));
         }
         obind->curar_sz = size;
     }
@@ -743,6 +973,48 @@ static VALUE set_max_chunk_size(VALUE klass, VALUE arg)
     return arg;
 }
 
+static VALUE get_chunk_pool_size(VALUE klass)
+{
+    return SIZET2NUM(chunk_pool_max_bytes);
+}
+
+/* Returns the number of bytes of chunks kept in the pool. */
+static VALUE get_chunk_pool_bytes(VALUE klass)
+{
+    size_t bytes;
+
+    CHUNK_POOL_LOCK();
+    bytes = chunk_pool_bytes;
+    CHUNK_POOL_UNLOCK();
+    return SIZET2NUM(bytes);
+}
+
+static VALUE set_chunk_pool_size(VALUE klass, VALUE arg)
+{
+    size_t size = NUM2SIZET(arg);
+    chunk_t *chunks = NULL;
+    chunk_t *chunk;
+    int i;
+
+    CHUNK_POOL_LOCK();
+    chunk_pool_max_bytes = size;
+    /* release pooled chunks over the new size. */
+    for (i = 0; i < CHUNK_POOL_CLASSES && chunk_pool_bytes > size; i++) {
+        while ((chunk = chunk_pool[i].head) != NULL && chunk_pool_bytes > size) {
+            chunk_pool[i].head = chunk->next;
+            chunk_pool_bytes -= chunk->alloc_len;
+            chunk->next = chunks;
+            chunks = chunk;
+        }
+    }
+    CHUNK_POOL_UNLOCK();
+    while ((chunk = chunks) != NULL) {
+        chunks = chunk->next;
+        xfree(chunk);
+    }
+    return arg;
+}
+
 static VALUE oci8_bind_initialize(VALUE self, VALUE svc, VALUE val, VALUE length, VALUE max_array_size)
 {
     oci8_bind_t *obind = TO_BIND(self);
@@ -806,13 +1078,18 @@ void oci8_bind_hp_obj_mark(oci8_base_t *base)
 
 void Init_oci8_bind(VALUE klass)
 {
+#ifdef _WIN32
+    InitializeCriticalSection(&chunk_pool_lock);
+#endif
     cOCI8BindTypeBase = klass;
     id_bind_type = rb_intern("bind_type");
     id_charset_form = rb_intern("charset_form");
+    id_owner = rb_intern("owner");
     sym_length = ID2SYM(rb_intern("length"));
     sym_length_semantics = ID2SYM(rb_intern("length_semantics"));
     sym_char = ID2SYM(rb_intern("char"));
     sym_nchar = ID2SYM(rb_intern("nchar"));
+    sym_max_size = ID2SYM(rb_intern("max_size"));
 
     rb_define_method(cOCI8BindTypeBase, "initialize", oci8_bind_initialize, 4);
     rb_define_method(cOCI8BindTypeBase, "get", oci8_bind_get, 0);
@@ -824,9 +1101,13 @@ void Init_oci8_bind(VALUE klass)
     rb_define_singleton_method(klass, "initial_chunk_size=", set_initial_chunk_size, 1);
     rb_define_singleton_method(klass, "max_chunk_size", get_max_chunk_size, 0);
     rb_define_singleton_method(klass, "max_chunk_size=", set_max_chunk_size, 1);
+    rb_define_singleton_method(klass, "chunk_pool_size", get_chunk_pool_size, 0);
+    rb_define_singleton_method(klass, "chunk_pool_size=", set_chunk_pool_size, 1);
+    rb_define_singleton_method(klass, "chunk_pool_bytes", get_chunk_pool_bytes, 0);
 
     /* register primitive data types. */
-    oci8_define_bind_class("String", &bind_string_data_type, bind_string_alloc);
+    klass = oci8_define_bind_class("String", &bind_string_data_type, bind_string_alloc);
+    rb_define_private_method(klass, "intern_strings=", bind_string_set_intern_strings, 1);
     oci8_define_bind_class("RAW", &bind_raw_data_type, bind_raw_alloc);
     oci8_define_bind_class("BinaryDouble", &bind_binary_double_data_type, bind_binary_double_alloc);
     if (oracle_client_version >= ORAVER_12_1) {
@@ -171,6 +171,15 @@ static VALUE set_backtrace(VALUE exc, const char *file, int line)
     return exc;
 }
 
+/*
+ * Makes an OCIError object from the error information in errhp
+ * without raising it.
+ */
+VALUE oci8_do_make_ocierror(OCIError *errhp, OCIStmt *stmthp, const char *file, int line)
+{
+    return oci8_make_exc(errhp, OCI_ERROR, OCI_HTYPE_ERROR, stmthp, file, line);
+}
+
 sb4 oci8_get_error_code(OCIError *errhp)
 {
     sb4 errcode = -1;
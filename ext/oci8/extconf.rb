@@ -66,7 +66,7 @@ if with_config('runtime-check')
 end
 
 $objs = ["oci8lib.o", "env.o", "error.o", "oci8.o", "ocihandle.o",
-         "connection_pool.o",
+         "connection_pool.o", "session_pool.o",
          "stmt.o", "bind.o", "metadata.o", "attr.o",
          "lob.o", "oradate.o",
          "ocinumber.o", "ocidatetime.o", "object.o", "apiwrap.o",
@@ -93,6 +93,9 @@ have_header("ruby/thread.h")
 have_func("rb_class_superclass", "ruby.h")
 have_func("rb_thread_call_without_gvl", "ruby/thread.h")
 have_func("rb_sym2str", "ruby.h")
+have_func("rb_enc_interned_str", "ruby/encoding.h")
+# ruby 3.0.0 headers
+have_func("rb_fiber_scheduler_current", "ruby/fiber/scheduler.h")
 if (defined? RUBY_ENGINE) && RUBY_ENGINE == 'rbx'
   have_func("rb_str_buf_cat_ascii", "ruby.h")
   have_func("rb_enc_str_buf_cat", "ruby.h")
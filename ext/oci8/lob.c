@@ -9,6 +9,10 @@
 static ID id_plus;
 static ID id_dir_alias;
 static ID id_filename;
+static ID id_write;
+static ID id_read;
+static ID id_next;
+static ID id_external_encoding;
 static VALUE cOCI8LOB;
 static VALUE cOCI8CLOB;
 static VALUE cOCI8NCLOB;
@@ -18,6 +22,13 @@ static VALUE seek_set;
 static VALUE seek_cur;
 static VALUE seek_end;
 
+#ifndef OCI_ATTR_LOBPREFETCH_SIZE
+#define OCI_ATTR_LOBPREFETCH_SIZE 439
+#endif
+#ifndef OCI_ATTR_LOBPREFETCH_LENGTH
+#define OCI_ATTR_LOBPREFETCH_LENGTH 440
+#endif
+
 #define TO_LOB(obj) ((oci8_lob_t *)oci8_check_typeddata((obj), &oci8_lob_data_type, 1))
 
 #ifndef MIN
@@ -71,6 +82,7 @@ static void oci8_lob_free(oci8_base_t *base)
         temp_lob->next = svcctx->temp_lobs;
         temp_lob->lob = lob->base.hp.lob;
         svcctx->temp_lobs = temp_lob;
+        svcctx->num_temp_lobs++;
         lob->base.type = 0;
         lob->base.closed = 1;
         lob->base.hp.ptr = NULL;
@@ -612,49 +624,47 @@ static void open_bfile(oci8_svcctx_t *svcctx, oci8_lob_t *lob, OCIError *errhp)
     }
 }
 
+/* The maximum size of a buffer passed to OCILobRead2() at once. */
+#define MAX_READ_PIECE_SIZE (128 * 1024 * 1024)
+/* The number of bytes read at once by LOB#read_into and LOB#each_chunk
+ * when the chunk size isn't specified. It is rounded up to a multiple
+ * of the LOB chunk size.
+ */
+#define DEFAULT_READ_CHUNK_SIZE (1024 * 1024)
+/* The default size of a buffer allocated per LOB by OCI8::LOB.read_all. */
+#define DEFAULT_ARRAY_READ_BUFFER_SIZE (64 * 1024)
+
 /*
- * @overload read
+ * Reads <sz> characters for CLOB and NCLOB or <sz> bytes for BLOB and
+ * BFILE from the current position and replaces the contents of <buf>
+ * with them. When <read_all> is true, it reads data until EOF.
+ * Pieces returned by OCILobRead2() are written to <buf> directly.
  *
- *  
- *
- *  @param [Integer] length number of characters if +self+ is a {CLOB} or a {NCLOB}.
- *    number of bytes if +self+ is a {BLOB} or a {BFILE}.
- *  @return [String or nil] data read. <code>nil</code> means it
- *    met EOF at beginning. It returns an empty string '' as a special exception
- *    when <i>length</i> is <code>nil</code> and the lob is empty.
- *
- * @overload read(length)
- *
- *  Reads <i>length</i> characters for {CLOB} and {NCLOB} or <i>length</i>
- *  bytes for {BLOB} and {BFILE} from the current position.
- *  If <i>length</i> is <code>nil</code>, it reads data until EOF.
- *
- *  @param [Integer] length number of characters if +self+ is a {CLOB} or a {NCLOB}.
- *    number of bytes if +self+ is a {BLOB} or a {BFILE}.
- *  @return [String or nil] data read. <code>nil</code> means it
- *    met EOF at beginning. It returns an empty string '' as a special exception
- *    when <i>length</i> is <code>nil</code> and the lob is empty.
+ * This returns the number of characters or bytes read.
  */
-static VALUE oci8_lob_read(int argc, VALUE *argv, VALUE self)
+static ub8 lob_read_to_str(oci8_lob_t *lob, oci8_svcctx_t *svcctx, ub8 sz, int read_all, VALUE buf)
 {
-    oci8_lob_t *lob = TO_LOB(self);
-    oci8_svcctx_t *svcctx = check_svcctx(lob);
+    ub8 start_pos = lob->pos;
     ub8 pos = lob->pos;
     long strbufsiz = 512;
-    ub8 sz;
+    long len = 0;
     ub8 byte_amt;
     ub8 char_amt;
     sword rv;
-    VALUE size;
-    VALUE v = rb_ary_new();
     OCIError *errhp = oci8_errhp;
     ub1 piece = OCI_FIRST_PIECE;
 
-    rb_scan_args(argc, argv, "01", &size);
-    if (NIL_P(size)) {
-        sz = UB4MAXVAL;
-    } else {
-        sz = NUM2ULL(size);
+    rb_str_modify(buf);
+    rb_str_set_len(buf, 0);
+    if (!read_all) {
+        /* Guess the number of bytes to read all data in a piece. */
+        ub8 guess = (lob->lobtype == OCI_TEMP_CLOB) ? sz * oci8_nls_ratio : sz;
+        if (guess > MAX_READ_PIECE_SIZE) {
+            guess = MAX_READ_PIECE_SIZE;
+        }
+        if ((long)guess > strbufsiz) {
+            strbufsiz = (long)guess;
+        }
     }
     if (lob->state == S_BFILE_CLOSE) {
         open_bfile(svcctx, lob, errhp);
@@ -668,10 +678,8 @@ read_more_data:
         char_amt = 0;
     }
     do {
-        VALUE strbuf = rb_str_buf_new(strbufsiz);
-        char *buf = RSTRING_PTR(strbuf);
-
-        rv = OCILobRead2_nb(svcctx, svcctx->base.hp.svc, errhp, lob->base.hp.lob, &byte_amt, &char_amt, pos + 1, buf, strbufsiz, piece, NULL, NULL, 0, lob->csfrm);
+        rb_str_resize(buf, len + strbufsiz);
+        rv = OCILobRead2_nb(svcctx, svcctx->base.hp.svc, errhp, lob->base.hp.lob, &byte_amt, &char_amt, pos + 1, RSTRING_PTR(buf) + len, strbufsiz, piece, NULL, NULL, 0, lob->csfrm);
         svcctx->suppress_free_temp_lobs = 0;
         switch (rv) {
         case OCI_SUCCESS:
@@ -684,49 +692,464 @@ read_more_data:
             piece = OCI_NEXT_PIECE;
             break;
         default:
+            rb_str_set_len(buf, len);
             chker2(rv, &svcctx->base);
         }
-        if (byte_amt == 0)
+        if (byte_amt == 0) {
+            rb_str_set_len(buf, len);
             break;
+        }
         if (lob->lobtype == OCI_TEMP_CLOB) {
             pos += char_amt;
         } else {
             pos += byte_amt;
         }
-        rb_str_set_len(strbuf, byte_amt);
-        rb_ary_push(v, strbuf);
-        if (strbufsiz < 128 * 1024 * 1024) {
+        len += (long)byte_amt;
+        rb_str_set_len(buf, len);
+        if (strbufsiz < MAX_READ_PIECE_SIZE) {
             strbufsiz *= 2;
         }
     } while (rv == OCI_NEED_DATA);
 
-    if (NIL_P(size) && pos - lob->pos == sz) {
+    if (read_all && pos - lob->pos == sz) {
+        /* lob->pos is the start position of the next pass. */
         lob->pos = pos;
         piece = OCI_FIRST_PIECE;
         goto read_more_data;
     }
     lob->pos = pos;
-    switch (RARRAY_LEN(v)) {
-    case 0:
-        if (NIL_P(size) && pos == 0) {
-            return rb_usascii_str_new("", 0);
+    return pos - start_pos;
+}
+
+/*
+ * Sets the encoding of data read by lob_read_to_str().
+ * This returns a converted string when Encoding.default_internal
+ * is set for CLOB and NCLOB.
+ */
+static VALUE lob_set_encoding(oci8_lob_t *lob, VALUE buf)
+{
+    if (lob->lobtype == OCI_TEMP_CLOB) {
+        /* set encoding */
+        rb_enc_associate(buf, oci8_encoding);
+        return rb_str_conv_enc(buf, oci8_encoding, rb_default_internal_encoding());
+    } else {
+        /* ASCII-8BIT */
+        rb_enc_associate(buf, rb_ascii8bit_encoding());
+        return buf;
+    }
+}
+
+/*
+ * Returns the number of characters or bytes read at once when
+ * the chunk size isn't specified.
+ */
+static ub8 lob_default_read_amount(oci8_lob_t *lob, oci8_svcctx_t *svcctx)
+{
+    ub4 chunk_size = 0;
+
+    if (lob->state == S_NO_OPEN_CLOSE
+        && OCILobGetChunkSize_nb(svcctx, svcctx->base.hp.svc, oci8_errhp, lob->base.hp.lob, &chunk_size) == OCI_SUCCESS
+        && chunk_size > 0) {
+        return ((DEFAULT_READ_CHUNK_SIZE + chunk_size - 1) / chunk_size) * chunk_size;
+    }
+    /* BFILE */
+    return DEFAULT_READ_CHUNK_SIZE;
+}
+
+/*
+ * @overload read
+ *
+ *  
+ *
+ *  @param [Integer] length number of characters if +self+ is a {CLOB} or a {NCLOB}.
+ *    number of bytes if +self+ is a {BLOB} or a {BFILE}.
+ *  @return [String or nil] data read. <code>nil</code> means it
+ *    met EOF at beginning. It returns an empty string '' as a special exception
+ *    when <i>length</i> is <code>nil</code> and the lob is empty.
+ *
+ * @overload read(length, outbuf = nil)
+ *
+ *  Reads <i>length</i> characters for {CLOB} and {NCLOB} or <i>length</i>
+ *  bytes for {BLOB} and {BFILE} from the current position.
+ *  If <i>length</i> is <code>nil</code>, it reads data until EOF.
+ *
+ *  When <i>outbuf</i> is given, the data read replaces its contents
+ *  and it is returned instead of a new string. (since 2.2.15)
+ *
+ *  @param [Integer] length number of characters if +self+ is a {CLOB} or a {NCLOB}.
+ *    number of bytes if +self+ is a {BLOB} or a {BFILE}.
+ *  @param [String] outbuf buffer to be reused
+ *  @return [String or nil] data read. <code>nil</code> means it
+ *    met EOF at beginning. It returns an empty string '' as a special exception
+ *    when <i>length</i> is <code>nil</code> and the lob is empty.
+ */
+static VALUE oci8_lob_read(int argc, VALUE *argv, VALUE self)
+{
+    oci8_lob_t *lob = TO_LOB(self);
+    oci8_svcctx_t *svcctx = check_svcctx(lob);
+    VALUE size, outbuf, str, v;
+    ub8 sz;
+
+    rb_scan_args(argc, argv, "02", &size, &outbuf);
+    if (NIL_P(size)) {
+        sz = UB4MAXVAL;
+    } else {
+        sz = NUM2ULL(size);
+    }
+    if (NIL_P(outbuf)) {
+        str = rb_str_buf_new(0);
+    } else {
+        StringValue(outbuf);
+        str = outbuf;
+    }
+    if (lob_read_to_str(lob, svcctx, sz, NIL_P(size), str) == 0) {
+        if (NIL_P(size) && lob->pos == 0) {
+            return NIL_P(outbuf) ? rb_usascii_str_new("", 0) : outbuf;
         } else {
             return Qnil;
         }
-    case 1:
-        v = RARRAY_AREF(v, 0);
-        break;
-    default:
-        v = rb_ary_join(v, Qnil);
     }
-    if (lob->lobtype == OCI_TEMP_CLOB) {
-        /* set encoding */
-        rb_enc_associate(v, oci8_encoding);
-        return rb_str_conv_enc(v, oci8_encoding, rb_default_internal_encoding());
+    v = lob_set_encoding(lob, str);
+    if (!NIL_P(outbuf) && v != outbuf) {
+        rb_str_replace(outbuf, v);
+        v = outbuf;
+    }
+    return v;
+}
+
+/*
+ * @overload read_into(io_or_buffer, length = nil)
+ *
+ *  Reads <i>length</i> characters for {CLOB} and {NCLOB} or <i>length</i>
+ *  bytes for {BLOB} and {BFILE} from the current position.
+ *  If <i>length</i> is <code>nil</code>, it reads data until EOF.
+ *
+ *  When <i>io_or_buffer</i> responds to +write+, the data are read by
+ *  a buffer reused for each chunk and written to it chunk by chunk.
+ *  The whole data are never held in memory at once.
+ *  Otherwise, <i>io_or_buffer</i> must be a String and its contents
+ *  are replaced with the data.
+ *
+ *  @example
+ *    File.open('image.png', 'wb') do |f|
+ *      blob.read_into(f)
+ *    end
+ *
+ *  @param [IO or String] io_or_buffer
+ *  @param [Integer] length number of characters if +self+ is a {CLOB} or a {NCLOB}.
+ *    number of bytes if +self+ is a {BLOB} or a {BFILE}.
+ *  @return [Integer] number of characters or bytes read
+ *
+ *  @since 2.2.15
+ */
+static VALUE oci8_lob_read_into(int argc, VALUE *argv, VALUE self)
+{
+    oci8_lob_t *lob = TO_LOB(self);
+    oci8_svcctx_t *svcctx = check_svcctx(lob);
+    VALUE target, size;
+    ub8 total = 0;
+
+    rb_scan_args(argc, argv, "11", &target, &size);
+    if (rb_respond_to(target, id_write)) {
+        ub8 amount = lob_default_read_amount(lob, svcctx);
+        VALUE buf = rb_str_buf_new(0);
+
+        while (NIL_P(size) || total < NUM2ULL(size)) {
+            ub8 sz = amount;
+            ub8 nread;
+
+            if (!NIL_P(size) && NUM2ULL(size) - total < sz) {
+                sz = NUM2ULL(size) - total;
+            }
+            nread = lob_read_to_str(lob, svcctx, sz, 0, buf);
+            if (nread == 0) {
+                break;
+            }
+            total += nread;
+            rb_funcall(target, id_write, 1, lob_set_encoding(lob, buf));
+            /* The block may close the LOB. */
+            lob = TO_LOB(self);
+            svcctx = check_svcctx(lob);
+        }
     } else {
-        /* ASCII-8BIT */
-        return v;
+        VALUE v;
+
+        StringValue(target);
+        total = lob_read_to_str(lob, svcctx, NIL_P(size) ? UB4MAXVAL : NUM2ULL(size), NIL_P(size), target);
+        v = lob_set_encoding(lob, target);
+        if (v != target) {
+            rb_str_replace(target, v);
+        }
+    }
+    return ULL2NUM(total);
+}
+
+/*
+ * @overload each_chunk(chunk_size = nil)
+ *
+ *  Reads data from the current position to EOF by <i>chunk_size</i>
+ *  characters for {CLOB} and {NCLOB} or <i>chunk_size</i> bytes for
+ *  {BLOB} and {BFILE} and yields them.
+ *  When <i>chunk_size</i> is +nil+, a multiple of {#chunk_size}
+ *  around one megabyte is used.
+ *
+ *  The yielded string is reused for the next chunk. Use
+ *  <code>String#dup</code> to keep it.
+ *
+ *  @example
+ *    blob.each_chunk do |chunk|
+ *      socket.write(chunk)
+ *    end
+ *
+ *  @param [Integer] chunk_size
+ *  @yieldparam [String] chunk
+ *  @return [self]
+ *
+ *  @since 2.2.15
+ */
+static VALUE oci8_lob_each_chunk(int argc, VALUE *argv, VALUE self)
+{
+    oci8_lob_t *lob;
+    oci8_svcctx_t *svcctx;
+    VALUE chunk_size;
+    VALUE buf;
+    ub8 amount;
+
+    RETURN_ENUMERATOR(self, argc, argv);
+    rb_scan_args(argc, argv, "01", &chunk_size);
+    lob = TO_LOB(self);
+    svcctx = check_svcctx(lob);
+    if (NIL_P(chunk_size)) {
+        amount = lob_default_read_amount(lob, svcctx);
+    } else {
+        amount = NUM2ULL(chunk_size);
+        if (amount == 0) {
+            rb_raise(rb_eArgError, "chunk_size must be positive");
+        }
+    }
+    buf = rb_str_buf_new(0);
+    while (lob_read_to_str(lob, svcctx, amount, 0, buf) != 0) {
+        rb_yield(lob_set_encoding(lob, buf));
+        /* The block may close the LOB. */
+        lob = TO_LOB(self);
+        svcctx = check_svcctx(lob);
     }
+    return self;
+}
+
+typedef struct {
+    VALUE lobs;
+    long *idx;
+    ub4 num;
+    long bufsiz;
+    VALUE result;
+    char *mem; /* memory for arrays and buffers passed to OCILobArrayRead() */
+} lob_array_read_arg_t;
+
+static VALUE lob_array_read_body(VALUE varg)
+{
+    lob_array_read_arg_t *arg = (lob_array_read_arg_t *)varg;
+    VALUE lobs = arg->lobs;
+    long *idx = arg->idx;
+    ub4 num = arg->num;
+    long bufsiz = arg->bufsiz;
+    VALUE result = arg->result;
+    oci8_lob_t *lob = TO_LOB(RARRAY_AREF(lobs, idx[0]));
+    oci8_svcctx_t *svcctx = check_svcctx(lob);
+    ub1 csfrm = lob->csfrm;
+    OCILobLocator **locs;
+    oraub8 *byte_amt;
+    oraub8 *char_amt;
+    oraub8 *offset;
+    oraub8 *bufl;
+    oraub8 *read_len; /* total length read, in characters for CLOBs */
+    void **bufp;
+    char *is_clob;
+    char *buf;
+    ub4 array_iter;
+    ub1 piece = OCI_FIRST_PIECE;
+    sword rv;
+    ub4 i;
+
+    /* OCI writes to them without the GVL. So they must not be
+     * memory of ruby objects.
+     */
+    arg->mem = ALLOC_N(char, (sizeof(oraub8) * 5 + sizeof(OCILobLocator *) + sizeof(void *) + 1) * num + bufsiz * num);
+    byte_amt = (oraub8 *)arg->mem;
+    char_amt = byte_amt + num;
+    offset = char_amt + num;
+    bufl = offset + num;
+    read_len = bufl + num;
+    locs = (OCILobLocator **)(read_len + num);
+    bufp = (void **)(locs + num);
+    is_clob = (char *)(bufp + num);
+    buf = is_clob + num;
+    for (i = 0; i < num; i++) {
+        lob = TO_LOB(RARRAY_AREF(lobs, idx[i]));
+        if (check_svcctx(lob) != svcctx) {
+            rb_raise(rb_eArgError, "LOBs belonging to different connections");
+        }
+        if (lob->state == S_BFILE_CLOSE) {
+            open_bfile(svcctx, lob, oci8_errhp);
+        }
+        locs[i] = lob->base.hp.lob;
+        byte_amt[i] = 0; /* read until EOF */
+        char_amt[i] = 0;
+        offset[i] = lob->pos + 1;
+        bufp[i] = buf + bufsiz * i;
+        bufl[i] = bufsiz;
+        read_len[i] = 0;
+        is_clob[i] = (lob->lobtype == OCI_TEMP_CLOB);
+        rb_ary_store(result, idx[i], rb_str_buf_new(0));
+    }
+    array_iter = num;
+    do {
+        rv = OCILobArrayRead_nb(svcctx, svcctx->base.hp.svc, oci8_errhp, &array_iter, locs, byte_amt, char_amt, offset, bufp, bufl, piece, NULL, NULL, 0, csfrm);
+        svcctx->suppress_free_temp_lobs = 0;
+        switch (rv) {
+        case OCI_SUCCESS:
+            break;
+        case OCI_NEED_DATA:
+            /* prevent OCILobFreeTemporary() from being called.
+             * See: https://github.com/kubo/ruby-oci8/issues/20
+             */
+            svcctx->suppress_free_temp_lobs = 1;
+            piece = OCI_NEXT_PIECE;
+            break;
+        default:
+            chker2(rv, &svcctx->base);
+        }
+        /* array_iter is the 1-based index of the LOB whose piece was read. */
+        if (array_iter >= 1 && array_iter <= num && byte_amt[array_iter - 1] > 0) {
+            i = array_iter - 1;
+            rb_str_cat(RARRAY_AREF(result, idx[i]), bufp[i], (long)byte_amt[i]);
+            /* char_amt is the number of characters in the piece for CLOBs. */
+            read_len[i] += is_clob[i] ? char_amt[i] : byte_amt[i];
+        }
+    } while (rv == OCI_NEED_DATA);
+
+    for (i = 0; i < num; i++) {
+        VALUE str = RARRAY_AREF(result, idx[i]);
+
+        lob = TO_LOB(RARRAY_AREF(lobs, idx[i]));
+        str = lob_set_encoding(lob, str);
+        lob->pos += read_len[i];
+        rb_ary_store(result, idx[i], str);
+    }
+    return Qnil;
+}
+
+static VALUE lob_array_read_ensure(VALUE varg)
+{
+    lob_array_read_arg_t *arg = (lob_array_read_arg_t *)varg;
+
+    xfree(arg->mem);
+    return Qnil;
+}
+
+/*
+ * Reads LOBs in <lobs> at <idx>[0..num-1] from their current positions
+ * to EOF by OCILobArrayRead() and stores them to <result>.
+ * All LOBs must belong to the same connection and have the same
+ * character set form.
+ */
+static void lob_array_read(VALUE lobs, long *idx, ub4 num, long bufsiz, VALUE result)
+{
+    lob_array_read_arg_t arg;
+
+    arg.lobs = lobs;
+    arg.idx = idx;
+    arg.num = num;
+    arg.bufsiz = bufsiz;
+    arg.result = result;
+    arg.mem = NULL;
+    rb_ensure(lob_array_read_body, (VALUE)&arg, lob_array_read_ensure, (VALUE)&arg);
+}
+
+/*
+ * @overload read_all(lobs, buffer_size = nil)
+ *
+ *  Reads each LOB in <i>lobs</i> from its current position to EOF
+ *  and returns an array of the data. +nil+ elements in <i>lobs</i>
+ *  are returned as +nil+.
+ *
+ *  All LOBs are read by one OCILobArrayRead() call on Oracle 11.1
+ *  client or upper. It requires one network round trip for LOBs
+ *  whose data fit in <i>buffer_size</i> bytes instead of one per LOB.
+ *  LOBs are read one by one on older clients.
+ *
+ *  @example
+ *    cursor = conn.exec('SELECT id, document FROM documents')
+ *    rows = cursor.fetch_all
+ *    docs = OCI8::LOB.read_all(rows.collect { |row| row[1] })
+ *
+ *  @param [Array<OCI8::LOB>] lobs LOBs belonging to the same connection
+ *  @param [Integer] buffer_size size of a buffer allocated per LOB.
+ *    The default is 64 kilobytes.
+ *  @return [Array<String>]
+ *
+ *  @since 2.2.15
+ */
+static VALUE oci8_lob_s_read_all(int argc, VALUE *argv, VALUE klass)
+{
+    VALUE lobs, buffer_size;
+    VALUE result;
+    long bufsiz = DEFAULT_ARRAY_READ_BUFFER_SIZE;
+    long *idx;
+    ub4 num[2] = {0, 0};
+    long i, len;
+    int j;
+    VALUE tmp;
+
+    rb_scan_args(argc, argv, "11", &lobs, &buffer_size);
+    lobs = rb_ary_dup(rb_Array(lobs));
+    if (!NIL_P(buffer_size)) {
+        bufsiz = NUM2LONG(buffer_size);
+        if (bufsiz <= 0) {
+            rb_raise(rb_eArgError, "buffer_size must be positive");
+        }
+    }
+    len = RARRAY_LEN(lobs);
+    result = rb_ary_new2(len);
+    for (i = 0; i < len; i++) {
+        rb_ary_store(result, i, Qnil);
+    }
+    if (!have_OCILobArrayRead_nb) {
+        /* Oracle 10.2 or lower */
+        for (i = 0; i < len; i++) {
+            VALUE lob = RARRAY_AREF(lobs, i);
+            if (!NIL_P(lob)) {
+                VALUE str = oci8_lob_read(0, NULL, lob);
+                if (NIL_P(str) || RSTRING_LEN(str) == 0) {
+                    /* return '' at EOF as OCILobArrayRead() */
+                    str = lob_set_encoding(TO_LOB(lob), rb_str_buf_new(0));
+                }
+                rb_ary_store(result, i, str);
+            }
+        }
+        return result;
+    }
+
+    /* Group LOBs by the character set form. idx[0..num[0]-1] are
+     * indexes of CLOB, BLOB and BFILE. idx[len..len+num[1]-1] are
+     * indexes of NCLOB.
+     */
+    tmp = rb_str_new(NULL, sizeof(long) * len * 2);
+    idx = (long *)RSTRING_PTR(tmp);
+    for (i = 0; i < len; i++) {
+        VALUE lob = RARRAY_AREF(lobs, i);
+        if (!NIL_P(lob)) {
+            j = (TO_LOB(lob)->csfrm == SQLCS_NCHAR) ? 1 : 0;
+            idx[len * j + num[j]++] = i;
+        }
+    }
+    for (j = 0; j < 2; j++) {
+        if (num[j] > 0) {
+            lob_array_read(lobs, idx + len * j, num[j], bufsiz, result);
+        }
+    }
+    RB_GC_GUARD(tmp);
+    return result;
 }
 
 /*
@@ -772,6 +1195,294 @@ static VALUE oci8_lob_write(VALUE self, VALUE data)
     }
 }
 
+/*
+ * The source of LOB#write_from.
+ */
+typedef struct {
+    VALUE src;         /* IO-like object or Enumerator */
+    int is_io;         /* true when src responds to read */
+    int state;         /* 0: reading, 1: met EOF, 2: flushed */
+    long piece_size;
+    VALUE bufs[2];     /* buffers passed to src.read alternately */
+    int bufidx;
+    int is_clob;
+    rb_encoding *enc;  /* CLOB: source encoding. NULL until the first piece is read. */
+    rb_econv_t *ec;    /* CLOB: converter to oci8_encoding. NULL when not required. */
+    VALUE carry;       /* CLOB: incomplete character at the end of the previous piece */
+} lob_write_src_t;
+
+typedef struct {
+    VALUE self;
+    oci8_svcctx_t *svcctx;
+    lob_write_src_t *w;
+    int in_progress;   /* true while OCILobWrite2() waits for the next piece */
+} lob_write_from_arg_t;
+
+static VALUE lob_write_src_enum_next(VALUE src)
+{
+    return rb_funcall(src, id_next, 0);
+}
+
+static VALUE lob_write_src_enum_stop(VALUE dummy, VALUE exc)
+{
+    return Qnil;
+}
+
+static VALUE lob_write_src_read(lob_write_src_t *w)
+{
+    VALUE chunk;
+
+    if (w->is_io) {
+        VALUE buf = w->bufs[w->bufidx];
+
+        w->bufidx ^= 1;
+        chunk = rb_funcall(w->src, id_read, 2, LONG2NUM(w->piece_size), buf);
+    } else {
+        chunk = rb_rescue2(lob_write_src_enum_next, w->src, lob_write_src_enum_stop, Qnil, rb_eStopIteration, (VALUE)0);
+    }
+    if (!NIL_P(chunk) && TYPE(chunk) != T_STRING) {
+        chunk = rb_obj_as_string(chunk);
+    }
+    return chunk;
+}
+
+/*
+ * Converts <chunk> to oci8_encoding. When the end of <chunk> is an
+ * incomplete character, it is kept until the next piece arrives so that
+ * a character isn't split over two pieces.
+ */
+static VALUE lob_write_src_encode(lob_write_src_t *w, VALUE chunk)
+{
+    const char *s, *e, *p;
+
+    if (w->enc == NULL) {
+        rb_encoding *enc = rb_enc_get(chunk);
+
+        if (enc == rb_ascii8bit_encoding()) {
+            /* IO#read(length) returns ASCII-8BIT strings. */
+            VALUE ext = Qnil;
+            if (w->is_io && rb_respond_to(w->src, id_external_encoding)) {
+                ext = rb_funcall(w->src, id_external_encoding, 0);
+            }
+            enc = NIL_P(ext) ? rb_default_external_encoding() : rb_to_encoding(ext);
+        }
+        if (enc != oci8_encoding) {
+            w->ec = rb_econv_open(rb_enc_name(enc), rb_enc_name(oci8_encoding), 0);
+            if (w->ec == NULL) {
+                rb_exc_raise(rb_econv_open_exc(rb_enc_name(enc), rb_enc_name(oci8_encoding), 0));
+            }
+        }
+        w->enc = enc;
+    }
+    if (w->ec != NULL) {
+        chunk = rb_econv_str_convert(w->ec, chunk, ECONV_PARTIAL_INPUT);
+        rb_econv_check_error(w->ec);
+        return chunk;
+    }
+    if (!NIL_P(w->carry)) {
+        chunk = rb_str_plus(w->carry, chunk);
+        w->carry = Qnil;
+    }
+    if (RSTRING_LEN(chunk) == 0) {
+        return chunk;
+    }
+    s = RSTRING_PTR(chunk);
+    e = RSTRING_END(chunk);
+    p = rb_enc_left_char_head(s, e - 1, e, oci8_encoding);
+    if (MBCLEN_NEEDMORE_P(rb_enc_precise_mbclen(p, e, oci8_encoding))) {
+        w->carry = rb_str_new(p, e - p);
+        chunk = rb_str_subseq(chunk, 0, p - s);
+    }
+    return chunk;
+}
+
+/*
+ * Returns the next non-empty piece or nil at EOF.
+ */
+static VALUE lob_write_src_next(lob_write_src_t *w)
+{
+    VALUE chunk;
+
+    while (w->state == 0) {
+        chunk = lob_write_src_read(w);
+        if (NIL_P(chunk)) {
+            w->state = 1;
+            break;
+        }
+        if (w->is_clob) {
+            chunk = lob_write_src_encode(w, chunk);
+        }
+        if (RSTRING_LEN(chunk) > 0) {
+            return chunk;
+        }
+    }
+    if (w->state == 1) {
+        w->state = 2;
+        if (w->ec != NULL) {
+            chunk = rb_econv_str_convert(w->ec, rb_str_new(NULL, 0), 0);
+            rb_econv_check_error(w->ec);
+            if (RSTRING_LEN(chunk) > 0) {
+                return chunk;
+            }
+        } else if (!NIL_P(w->carry)) {
+            chunk = w->carry;
+            w->carry = Qnil;
+            return chunk;
+        }
+    }
+    return Qnil;
+}
+
+static VALUE lob_write_from_body(VALUE data)
+{
+    lob_write_from_arg_t *arg = (lob_write_from_arg_t *)data;
+    lob_write_src_t *w = arg->w;
+    oci8_lob_t *lob = TO_LOB(arg->self);
+    oci8_svcctx_t *svcctx = arg->svcctx;
+    VALUE cur, nxt;
+    ub8 byte_amt = 0;
+    ub8 char_amt = 0;
+    ub8 total = 0;
+    ub1 piece;
+    sword rv;
+
+    cur = lob_write_src_next(w);
+    if (NIL_P(cur)) {
+        return INT2FIX(0);
+    }
+    nxt = lob_write_src_next(w);
+    if (NIL_P(nxt)) {
+        /* all data fit in a piece. */
+        piece = OCI_ONE_PIECE;
+        byte_amt = RSTRING_LEN(cur);
+    } else {
+        /* streaming mode: the total amount is unknown. */
+        piece = OCI_FIRST_PIECE;
+    }
+    for (;;) {
+        rv = OCILobWrite2_nb(svcctx, svcctx->base.hp.svc, oci8_errhp, lob->base.hp.lob, &byte_amt, &char_amt, lob->pos + 1, RSTRING_PTR(cur), RSTRING_LEN(cur), piece, NULL, NULL, 0, lob->csfrm);
+        svcctx->suppress_free_temp_lobs = 0;
+        arg->in_progress = 0;
+        if (rv != OCI_SUCCESS && rv != OCI_NEED_DATA) {
+            chker2(rv, &svcctx->base);
+        }
+        if (lob->lobtype == OCI_TEMP_CLOB) {
+            total += rb_enc_strlen(RSTRING_PTR(cur), RSTRING_END(cur), oci8_encoding);
+        } else {
+            total += RSTRING_LEN(cur);
+        }
+        if (rv != OCI_NEED_DATA) {
+            break;
+        }
+        /* prevent OCILobFreeTemporary() from being called while
+         * the next piece is read.
+         * See: https://github.com/kubo/ruby-oci8/issues/20
+         */
+        svcctx->suppress_free_temp_lobs = 1;
+        arg->in_progress = 1;
+        cur = nxt;
+        nxt = lob_write_src_next(w);
+        piece = NIL_P(nxt) ? OCI_LAST_PIECE : OCI_NEXT_PIECE;
+    }
+    RB_GC_GUARD(cur);
+    RB_GC_GUARD(nxt);
+    lob->pos += total;
+    return ULL2NUM(total);
+}
+
+static VALUE lob_write_from_ensure(VALUE data)
+{
+    lob_write_from_arg_t *arg = (lob_write_from_arg_t *)data;
+
+    if (arg->in_progress) {
+        /* Reading the next piece failed. Cancel the piecewise write. */
+        oci8_svcctx_t *svcctx = arg->svcctx;
+
+        svcctx->suppress_free_temp_lobs = 0;
+        OCIBreak(svcctx->base.hp.ptr, oci8_errhp);
+        OCIReset(svcctx->base.hp.ptr, oci8_errhp);
+    }
+    if (arg->w->ec != NULL) {
+        rb_econv_close(arg->w->ec);
+        arg->w->ec = NULL;
+    }
+    return Qnil;
+}
+
+/*
+ * @overload write_from(io_or_enum, piece_size = nil)
+ *
+ *  Writes data read from <i>io_or_enum</i> at the current position
+ *  piece by piece. The whole data are never held in memory at once.
+ *
+ *  When <i>io_or_enum</i> responds to +read+, data are read by
+ *  <code>io_or_enum.read(piece_size, buffer)</code> with two buffers
+ *  reused alternately until it returns +nil+. Otherwise, pieces
+ *  are taken from <i>io_or_enum</i> by +next+ until +StopIteration+.
+ *  When <i>piece_size</i> is +nil+, a multiple of {#chunk_size}
+ *  around one megabyte is used.
+ *
+ *  Data for {CLOB} and {NCLOB} are converted to {OCI8.encoding}
+ *  piece by piece. A character split over two pieces is written
+ *  as a whole with the latter piece.
+ *  The source encoding is the encoding of the first piece, or
+ *  <code>io_or_enum.external_encoding</code> or
+ *  <code>Encoding.default_external</code> when the piece is
+ *  an ASCII-8BIT string.
+ *
+ *  The connection must not be used until this method returns.
+ *
+ *  @example
+ *    File.open('image.png', 'rb') do |f|
+ *      blob.write_from(f)
+ *    end
+ *
+ *  @param [IO or Enumerator] io_or_enum
+ *  @param [Integer] piece_size number of bytes passed to +read+
+ *  @return [Integer] number of characters written if +self+ is a {CLOB} or a {NCLOB}.
+ *    number of bytes written if +self+ is a {BLOB}.
+ *
+ *  @since 2.2.15
+ */
+static VALUE oci8_lob_write_from(int argc, VALUE *argv, VALUE self)
+{
+    oci8_lob_t *lob = TO_LOB(self);
+    oci8_svcctx_t *svcctx = check_svcctx(lob);
+    VALUE src, piece_size;
+    lob_write_src_t w;
+    lob_write_from_arg_t arg;
+
+    rb_scan_args(argc, argv, "11", &src, &piece_size);
+    if (lob->state != S_NO_OPEN_CLOSE) {
+        rb_raise(rb_eRuntimeError, "cannot modify a read-only BFILE object");
+    }
+    memset(&w, 0, sizeof(w));
+    w.src = src;
+    w.is_io = rb_respond_to(src, id_read);
+    w.is_clob = (lob->lobtype == OCI_TEMP_CLOB);
+    w.carry = Qnil;
+    if (w.is_io) {
+        if (NIL_P(piece_size)) {
+            ub8 amount = lob_default_read_amount(lob, svcctx);
+            w.piece_size = (long)amount;
+        } else {
+            w.piece_size = NUM2LONG(piece_size);
+            if (w.piece_size <= 0) {
+                rb_raise(rb_eArgError, "piece_size must be positive");
+            }
+        }
+        w.bufs[0] = rb_str_buf_new(w.piece_size);
+        w.bufs[1] = rb_str_buf_new(w.piece_size);
+    } else {
+        w.bufs[0] = w.bufs[1] = Qnil;
+    }
+    arg.self = self;
+    arg.svcctx = svcctx;
+    arg.w = &w;
+    arg.in_progress = 0;
+    return rb_ensure(lob_write_from_body, (VALUE)&arg, lob_write_from_ensure, (VALUE)&arg);
+}
+
 /*
  *  @deprecated LOB#sync had not worked by mistake. Do nothing now.
  *  @private
@@ -819,6 +1530,16 @@ static VALUE oci8_lob_get_chunk_size(VALUE self)
     return UINT2NUM(len);
 }
 
+/*
+ * @overload dup
+ *
+ *  Returns a copy of the LOB locator. Use this to keep a LOB
+ *  fetched by a cursor whose {OCI8::Cursor#reuse_lobs=} is true.
+ *
+ *  @return [OCI8::LOB]
+ *
+ *  @since 2.2.15
+ */
 static VALUE oci8_lob_clone(VALUE self)
 {
     oci8_lob_t *lob = TO_LOB(self);
@@ -1036,12 +1757,96 @@ typedef struct {
     VALUE *klass;
 } oci8_bind_lob_data_type_t;
 
+typedef struct {
+    oci8_bind_t obind;
+    ub4 prefetch_size; /* LOBs not longer than this are fetched as String. */
+    ub1 reuse_lobs;    /* LOB objects in the define buffer are returned. */
+} oci8_bind_lob_t;
+
+/*
+ * Reads a fetched LOB as a String when its length is not longer than
+ * <max_len>. Otherwise, this returns nil. The length and data are
+ * served from data prefetched with the locator and no round trip
+ * is required.
+ */
+static VALUE lob_get_inline(oci8_lob_t *lob, ub4 max_len)
+{
+    oci8_svcctx_t *svcctx = check_svcctx(lob);
+    VALUE buf;
+    ub8 len;
+
+    if (lob->state != S_NO_OPEN_CLOSE) {
+        /* BFILE */
+        return Qnil;
+    }
+    len = oci8_lob_get_length(lob);
+    if (len > max_len) {
+        return Qnil;
+    }
+    buf = rb_str_buf_new(0);
+    if (len > 0) {
+        lob->pos = 0;
+        lob_read_to_str(lob, svcctx, len, 0, buf);
+        lob->pos = 0;
+    }
+    return lob_set_encoding(lob, buf);
+}
+
 static VALUE bind_lob_get(oci8_bind_t *obind, void *data, void *null_struct)
 {
+    oci8_bind_lob_t *obl = (oci8_bind_lob_t *)obind;
     oci8_hp_obj_t *oho = (oci8_hp_obj_t *)data;
+
+    if (obl->prefetch_size > 0) {
+        VALUE str = lob_get_inline(TO_LOB(oho->obj), obl->prefetch_size);
+        if (!NIL_P(str)) {
+            return str;
+        }
+    }
+    if (obl->reuse_lobs) {
+        return oho->obj;
+    }
     return oci8_lob_clone(oho->obj);
 }
 
+/*
+ * @overload reuse_lobs=(val)
+ *
+ *  When +val+ is true, LOB objects in the define buffer are returned
+ *  instead of their copies and are reused by the next fetch.
+ *
+ *  @private
+ */
+static VALUE bind_lob_set_reuse_lobs(VALUE self, VALUE val)
+{
+    oci8_bind_lob_t *obl = (oci8_bind_lob_t *)TO_BIND(self);
+
+    obl->reuse_lobs = RTEST(val) ? 1 : 0;
+    return val;
+}
+
+/*
+ * @overload lob_prefetch_size=(size)
+ *
+ *  Sets the LOB prefetch size and the LOB length prefetch of the
+ *  define handle. LOBs not longer than +size+ are fetched as String.
+ *
+ *  @private
+ */
+static VALUE bind_lob_set_prefetch_size(VALUE self, VALUE size)
+{
+    oci8_bind_lob_t *obl = (oci8_bind_lob_t *)TO_BIND(self);
+    ub4 sz = NUM2UINT(size);
+    boolean prefetch_length = sz > 0 ? TRUE : FALSE;
+
+    chker2(OCIAttrSet(obl->obind.base.hp.ptr, obl->obind.base.type, (void*)&sz, 0, OCI_ATTR_LOBPREFETCH_SIZE, oci8_errhp),
+           &obl->obind.base);
+    chker2(OCIAttrSet(obl->obind.base.hp.ptr, obl->obind.base.type, (void*)&prefetch_length, 0, OCI_ATTR_LOBPREFETCH_LENGTH, oci8_errhp),
+           &obl->obind.base);
+    obl->prefetch_size = sz;
+    return size;
+}
+
 static void bind_lob_set(oci8_bind_t *obind, void *data, void **null_structp, VALUE val)
 {
     oci8_hp_obj_t *oho = (oci8_hp_obj_t *)data;
@@ -1073,6 +1878,34 @@ static void bind_lob_init_elem(oci8_bind_t *obind, VALUE svc)
     } while (++idx < obind->maxar_sz);
 }
 
+/*
+ * Prepares LOB objects returned by the previous fetch for the next
+ * fetch when they are reused.
+ */
+static void bind_lob_pre_fetch_hook(oci8_bind_t *obind, VALUE svc)
+{
+    oci8_bind_lob_t *obl = (oci8_bind_lob_t *)obind;
+    const oci8_bind_lob_data_type_t *data_type = (const oci8_bind_lob_data_type_t *)obind->base.data_type;
+    oci8_hp_obj_t *oho = (oci8_hp_obj_t *)obind->valuep;
+    ub4 idx = 0;
+
+    if (!obl->reuse_lobs) {
+        return;
+    }
+    do {
+        oci8_lob_t *lob = DATA_PTR(oho[idx].obj);
+
+        if (lob->base.closed) {
+            /* closed by the user. */
+            oho[idx].obj = rb_class_new_instance(1, &svc, *data_type->klass);
+            RB_OBJ_WRITTEN(obind->base.self, Qundef, oho[idx].obj);
+            lob = DATA_PTR(oho[idx].obj);
+            oho[idx].hp = lob->base.hp.ptr;
+        }
+        lob->pos = 0;
+    } while (++idx < obind->maxar_sz);
+}
+
 static void bind_lob_post_bind_hook_for_nclob(oci8_bind_t *obind)
 {
     ub1 csfrm = SQLCS_NCHAR;
@@ -1097,13 +1930,13 @@ static const oci8_bind_lob_data_type_t bind_clob_data_type = {
 #endif
             },
             oci8_bind_free,
-            sizeof(oci8_bind_t)
+            sizeof(oci8_bind_lob_t)
         },
         bind_lob_get,
         bind_lob_set,
         bind_lob_init,
         bind_lob_init_elem,
-        NULL,
+        bind_lob_pre_fetch_hook,
         SQLT_CLOB
     },
     &cOCI8CLOB
@@ -1130,13 +1963,13 @@ static const oci8_bind_lob_data_type_t bind_nclob_data_type = {
 #endif
             },
             oci8_bind_free,
-            sizeof(oci8_bind_t)
+            sizeof(oci8_bind_lob_t)
         },
         bind_lob_get,
         bind_lob_set,
         bind_lob_init,
         bind_lob_init_elem,
-        NULL,
+        bind_lob_pre_fetch_hook,
         SQLT_CLOB,
         bind_lob_post_bind_hook_for_nclob,
     },
@@ -1164,13 +1997,13 @@ static const oci8_bind_lob_data_type_t bind_blob_data_type = {
 #endif
             },
             oci8_bind_free,
-            sizeof(oci8_bind_t)
+            sizeof(oci8_bind_lob_t)
         },
         bind_lob_get,
         bind_lob_set,
         bind_lob_init,
         bind_lob_init_elem,
-        NULL,
+        bind_lob_pre_fetch_hook,
         SQLT_BLOB
     },
     &cOCI8BLOB
@@ -1197,13 +2030,13 @@ static const oci8_bind_lob_data_type_t bind_bfile_data_type = {
 #endif
             },
             oci8_bind_free,
-            sizeof(oci8_bind_t)
+            sizeof(oci8_bind_lob_t)
         },
         bind_lob_get,
         bind_lob_set,
         bind_lob_init,
         bind_lob_init_elem,
-        NULL,
+        bind_lob_pre_fetch_hook,
         SQLT_BFILE
     },
     &cOCI8BFILE
@@ -1216,9 +2049,15 @@ static VALUE bind_bfile_alloc(VALUE klass)
 
 void Init_oci8_lob(VALUE cOCI8)
 {
+    VALUE klass;
+
     id_plus = rb_intern("+");
     id_dir_alias = rb_intern("@dir_alias");
     id_filename = rb_intern("@filename");
+    id_write = rb_intern("write");
+    id_read = rb_intern("read");
+    id_next = rb_intern("next");
+    id_external_encoding = rb_intern("external_encoding");
     seek_set = rb_eval_string("::IO::SEEK_SET");
     seek_cur = rb_eval_string("::IO::SEEK_CUR");
     seek_end = rb_eval_string("::IO::SEEK_END");
@@ -1240,6 +2079,7 @@ void Init_oci8_lob(VALUE cOCI8)
     cOCI8BLOB = oci8_define_class_under(cOCI8, "BLOB", &oci8_blob_data_type, oci8_blob_alloc);
     cOCI8BFILE = oci8_define_class_under(cOCI8, "BFILE", &oci8_bfile_data_type, oci8_bfile_alloc);
 
+    rb_define_singleton_method(cOCI8LOB, "read_all", oci8_lob_s_read_all, -1);
     rb_define_method(cOCI8CLOB, "initialize", oci8_clob_initialize, -1);
     rb_define_method(cOCI8NCLOB, "initialize", oci8_nclob_initialize, -1);
     rb_define_method(cOCI8BLOB, "initialize", oci8_blob_initialize, -1);
@@ -1253,12 +2093,16 @@ void Init_oci8_lob(VALUE cOCI8)
     rb_define_method(cOCI8LOB, "truncate", oci8_lob_truncate, 1);
     rb_define_method(cOCI8LOB, "size=", oci8_lob_set_size, 1);
     rb_define_method(cOCI8LOB, "read", oci8_lob_read, -1);
+    rb_define_method(cOCI8LOB, "read_into", oci8_lob_read_into, -1);
+    rb_define_method(cOCI8LOB, "each_chunk", oci8_lob_each_chunk, -1);
     rb_define_method(cOCI8LOB, "write", oci8_lob_write, 1);
+    rb_define_method(cOCI8LOB, "write_from", oci8_lob_write_from, -1);
     rb_define_method(cOCI8LOB, "close", oci8_lob_close, 0);
     rb_define_method(cOCI8LOB, "sync", oci8_lob_get_sync, 0);
     rb_define_method(cOCI8LOB, "sync=", oci8_lob_set_sync, 1);
     rb_define_method(cOCI8LOB, "flush", oci8_lob_flush, 0);
     rb_define_method(cOCI8LOB, "chunk_size", oci8_lob_get_chunk_size, 0);
+    rb_define_method(cOCI8LOB, "dup", oci8_lob_clone, 0);
 
     rb_define_method(cOCI8BFILE, "initialize", oci8_bfile_initialize, -1);
     rb_define_method(cOCI8BFILE, "dir_alias", oci8_bfile_get_dir_alias, 0);
@@ -1270,8 +2114,14 @@ void Init_oci8_lob(VALUE cOCI8)
     rb_define_method(cOCI8BFILE, "size=", oci8_bfile_error, 1);
     rb_define_method(cOCI8BFILE, "write", oci8_bfile_error, 1);
 
-    oci8_define_bind_class("CLOB", &bind_clob_data_type.bind, bind_clob_alloc);
-    oci8_define_bind_class("NCLOB", &bind_nclob_data_type.bind, bind_nclob_alloc);
-    oci8_define_bind_class("BLOB", &bind_blob_data_type.bind, bind_blob_alloc);
+    klass = oci8_define_bind_class("CLOB", &bind_clob_data_type.bind, bind_clob_alloc);
+    rb_define_private_method(klass, "lob_prefetch_size=", bind_lob_set_prefetch_size, 1);
+    rb_define_private_method(klass, "reuse_lobs=", bind_lob_set_reuse_lobs, 1);
+    klass = oci8_define_bind_class("NCLOB", &bind_nclob_data_type.bind, bind_nclob_alloc);
+    rb_define_private_method(klass, "lob_prefetch_size=", bind_lob_set_prefetch_size, 1);
+    rb_define_private_method(klass, "reuse_lobs=", bind_lob_set_reuse_lobs, 1);
+    klass = oci8_define_bind_class("BLOB", &bind_blob_data_type.bind, bind_blob_alloc);
+    rb_define_private_method(klass, "lob_prefetch_size=", bind_lob_set_prefetch_size, 1);
+    rb_define_private_method(klass, "reuse_lobs=", bind_lob_set_reuse_lobs, 1);
     oci8_define_bind_class("BFILE", &bind_bfile_data_type.bind, bind_bfile_alloc);
 }
@@ -34,9 +34,23 @@ extern rb_pid_t rb_w32_getpid(void);
 #define OCI_ATTR_TRANSACTION_IN_PROGRESS 484
 #endif
 
+#ifndef OCI_HTYPE_AUTHINFO
+#define OCI_HTYPE_AUTHINFO 9
+#endif
+#ifndef OCI_ATTR_CONNECTION_CLASS
+#define OCI_ATTR_CONNECTION_CLASS 425
+#endif
+#ifndef OCI_ATTR_PURITY
+#define OCI_ATTR_PURITY 426
+#endif
+#ifndef OCI_SESSRLS_RETAG
+#define OCI_SESSRLS_RETAG 0x0002
+#endif
+
 #define OCI8_STATE_SESSION_BEGIN_WAS_CALLED 0x01
 #define OCI8_STATE_SERVER_ATTACH_WAS_CALLED 0x02
 #define OCI8_STATE_CPOOL 0x04
+#define OCI8_STATE_SPOOL_RETAG 0x08
 
 static VALUE cOCI8;
 static VALUE cSession;
@@ -193,6 +207,7 @@ static void oci8_svcctx_free(oci8_base_t *base)
         lob = lob_next;
     }
     svcctx->temp_lobs = NULL;
+    svcctx->num_temp_lobs = 0;
 
     if (svcctx->logoff_strategy != NULL) {
         const oci8_logoff_strategy_t *strategy = svcctx->logoff_strategy;
@@ -488,6 +503,78 @@ static const oci8_logoff_strategy_t complex_logoff = {
     complex_logoff_execute,
 };
 
+/*
+ * Logoff strategy for sessions got from a session pool by OCISessionGet.
+ */
+
+typedef struct {
+    OCISvcCtx *svchp;
+    OCISession *usrhp;
+    OraText *tag;
+    ub4 tag_len;
+    ub4 mode;
+} spool_logoff_arg_t;
+
+static void *spool_logoff_prepare(oci8_svcctx_t *svcctx)
+{
+    spool_logoff_arg_t *sla = malloc(sizeof(spool_logoff_arg_t));
+    sla->svchp = svcctx->base.hp.svc;
+    sla->usrhp = svcctx->usrhp;
+    sla->tag = svcctx->spool_tag;
+    sla->tag_len = svcctx->spool_tag_len;
+    sla->mode = (svcctx->state & OCI8_STATE_SPOOL_RETAG) ? OCI_SESSRLS_RETAG : OCI_DEFAULT;
+    svcctx->usrhp = NULL;
+    svcctx->srvhp = NULL;
+    svcctx->spool_tag = NULL;
+    svcctx->spool_tag_len = 0;
+    svcctx->state = 0;
+    return sla;
+}
+
+static void *spool_logoff_execute(void *arg)
+{
+    spool_logoff_arg_t *sla = (spool_logoff_arg_t *)arg;
+    OCIError *errhp = oci8_errhp;
+    boolean txn = TRUE;
+    sword rv;
+
+    if (oracle_client_version >= ORAVER_12_1) {
+        OCIAttrGet(sla->usrhp, OCI_HTYPE_SESSION, &txn, NULL, OCI_ATTR_TRANSACTION_IN_PROGRESS, errhp);
+    }
+    if (txn) {
+        OCITransRollback(sla->svchp, errhp, OCI_DEFAULT);
+    }
+    /* The session returns to the pool. The service context handle
+     * is freed by this.
+     */
+    rv = OCISessionRelease(sla->svchp, errhp, sla->tag, sla->tag_len, sla->mode);
+    free(sla->tag);
+    free(sla);
+    return (void*)(VALUE)rv;
+}
+
+static const oci8_logoff_strategy_t spool_logoff = {
+    spool_logoff_prepare,
+    spool_logoff_execute,
+};
+
+static void set_server_version(oci8_svcctx_t *svcctx)
+{
+    char buf[100];
+    ub4 version;
+
+    if (have_OCIServerRelease2) {
+        chker2(OCIServerRelease2(svcctx->base.hp.ptr, oci8_errhp, (text*)buf,
+                                 sizeof(buf), (ub1)svcctx->base.type, &version, OCI_DEFAULT),
+               &svcctx->base);
+    } else {
+        chker2(OCIServerRelease(svcctx->base.hp.ptr, oci8_errhp, (text*)buf,
+                                sizeof(buf), (ub1)svcctx->base.type, &version),
+               &svcctx->base);
+    }
+    svcctx->server_version = version;
+}
+
 /*
  * @overload allocate_handles()
  *
@@ -582,8 +669,6 @@ static VALUE oci8_server_attach(VALUE self, VALUE dbname, VALUE attach_mode)
 static VALUE oci8_session_begin(VALUE self, VALUE cred, VALUE mode)
 {
     oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
-    char buf[100];
-    ub4 version;
 
     if (svcctx->logoff_strategy != &complex_logoff) {
         rb_raise(rb_eRuntimeError, "Use this method only for the service context handle created by OCI8#server_handle().");
@@ -606,24 +691,143 @@ static VALUE oci8_session_begin(VALUE self, VALUE cred, VALUE mode)
                       oci8_errhp),
            &svcctx->base);
     svcctx->state |= OCI8_STATE_SESSION_BEGIN_WAS_CALLED;
-    if (have_OCIServerRelease2) {
-        chker2(OCIServerRelease2(svcctx->base.hp.ptr, oci8_errhp, (text*)buf,
-                                 sizeof(buf), (ub1)svcctx->base.type, &version, OCI_DEFAULT),
-               &svcctx->base);
-    } else {
-        chker2(OCIServerRelease(svcctx->base.hp.ptr, oci8_errhp, (text*)buf,
-                                sizeof(buf), (ub1)svcctx->base.type, &version),
-               &svcctx->base);
-    }
-    svcctx->server_version = version;
+    set_server_version(svcctx);
     return Qnil;
 }
 
+static sword set_authinfo_string(OCIAuthInfo *authhp, VALUE val, ub4 attr)
+{
+    if (NIL_P(val)) {
+        return OCI_SUCCESS;
+    }
+    return OCIAttrSet(authhp, OCI_HTYPE_AUTHINFO, RSTRING_PTR(val), RSTRING_LENINT(val), attr, oci8_errhp);
+}
+
+/*
+ * @overload session_get(pool_name, username, password, tag, connection_class, purity, mode)
+ *
+ *  Gets a session from a session pool by the OCI function OCISessionGet().
+ *
+ *  @param [String] pool_name
+ *  @param [String] username
+ *  @param [String] password
+ *  @param [String] tag
+ *  @param [String] connection_class
+ *  @param [Integer] purity
+ *  @param [Integer] mode
+ *  @return [Array] the tag of the session and whether a session with +tag+ was found
+ *  @private
+ */
+static VALUE oci8_session_get(VALUE self, VALUE pool_name, VALUE username, VALUE password, VALUE tag, VALUE connection_class, VALUE purity, VALUE mode)
+{
+    oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
+    OCIAuthInfo *authhp = NULL;
+    OraText *ret_tag = NULL;
+    ub4 ret_tag_len = 0;
+    boolean found = FALSE;
+    ub4 purity_val;
+    sword rv;
+
+    if (svcctx->logoff_strategy != NULL) {
+        rb_raise(rb_eRuntimeError, "Could not reuse the session.");
+    }
+
+    /* check arguments */
+    OCI8SafeStringValue(pool_name);
+    if (!NIL_P(username)) {
+        OCI8SafeStringValue(username);
+    }
+    if (!NIL_P(password)) {
+        OCI8SafeStringValue(password);
+    }
+    if (!NIL_P(tag)) {
+        OCI8SafeStringValue(tag);
+    }
+    if (!NIL_P(connection_class)) {
+        OCI8SafeStringValue(connection_class);
+    }
+    purity_val = NUM2UINT(purity);
+
+    rv = OCIHandleAlloc(oci8_envhp, (void*)&authhp, OCI_HTYPE_AUTHINFO, 0, 0);
+    if (rv != OCI_SUCCESS)
+        oci8_env_raise(oci8_envhp, rv);
+    rv = set_authinfo_string(authhp, username, OCI_ATTR_USERNAME);
+    if (rv == OCI_SUCCESS) {
+        rv = set_authinfo_string(authhp, password, OCI_ATTR_PASSWORD);
+    }
+    if (rv == OCI_SUCCESS) {
+        rv = set_authinfo_string(authhp, connection_class, OCI_ATTR_CONNECTION_CLASS);
+    }
+    if (rv == OCI_SUCCESS && purity_val != 0) {
+        rv = OCIAttrSet(authhp, OCI_HTYPE_AUTHINFO, &purity_val, 0, OCI_ATTR_PURITY, oci8_errhp);
+    }
+    if (rv == OCI_SUCCESS) {
+        rv = OCISessionGet_nb(svcctx, oci8_envhp, oci8_errhp, &svcctx->base.hp.svc, authhp,
+                              RSTRING_ORATEXT(pool_name), RSTRING_LEN(pool_name),
+                              NIL_P(tag) ? NULL : RSTRING_ORATEXT(tag),
+                              NIL_P(tag) ? 0 : RSTRING_LEN(tag),
+                              &ret_tag, &ret_tag_len, &found, NUM2UINT(mode));
+    }
+    OCIHandleFree(authhp, OCI_HTYPE_AUTHINFO);
+    chker2(rv, &svcctx->base);
+    svcctx->base.type = OCI_HTYPE_SVCCTX;
+    svcctx->logoff_strategy = &spool_logoff;
+    svcctx->state = 0;
+
+    chker2(OCIAttrGet(svcctx->base.hp.ptr, OCI_HTYPE_SVCCTX, &svcctx->usrhp, 0, OCI_ATTR_SESSION, oci8_errhp),
+           &svcctx->base);
+    copy_session_handle(svcctx);
+    chker2(OCIAttrGet(svcctx->base.hp.ptr, OCI_HTYPE_SVCCTX, &svcctx->srvhp, 0, OCI_ATTR_SERVER, oci8_errhp),
+           &svcctx->base);
+    copy_server_handle(svcctx);
+    set_server_version(svcctx);
+    return rb_assoc_new(ret_tag_len ? rb_str_new(TO_CHARPTR(ret_tag), ret_tag_len) : Qnil,
+                        found ? Qtrue : Qfalse);
+}
+
+/*
+ * @overload set_release_tag(tag)
+ *
+ *  Sets the tag passed to OCISessionRelease() when the session
+ *  returns to the session pool.
+ *
+ *  @param [String] tag
+ *  @private
+ */
+static VALUE oci8_set_release_tag(VALUE self, VALUE tag)
+{
+    oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
+    OraText *buf = NULL;
+    ub4 len = 0;
+
+    if (svcctx->logoff_strategy != &spool_logoff) {
+        rb_raise(rb_eRuntimeError, "The session isn't got from a session pool.");
+    }
+    if (!NIL_P(tag)) {
+        OCI8SafeStringValue(tag);
+        len = RSTRING_LENINT(tag);
+        /* freed by spool_logoff_execute() in a native thread */
+        buf = malloc(len + 1);
+        if (buf == NULL) {
+            rb_memerror();
+        }
+        memcpy(buf, RSTRING_PTR(tag), len);
+        buf[len] = '\0';
+    }
+    free(svcctx->spool_tag);
+    svcctx->spool_tag = buf;
+    svcctx->spool_tag_len = len;
+    svcctx->state |= OCI8_STATE_SPOOL_RETAG;
+    return tag;
+}
+
 /*
- * @overload logoff
+ * @overload __logoff
  *
  *  Disconnects from the Oracle server. The uncommitted transaction is
  *  rollbacked.
+ *
+ *  @private
  */
 static VALUE oci8_svcctx_logoff(VALUE self)
 {
@@ -652,6 +856,7 @@ static VALUE oci8_commit(VALUE self)
 {
     oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
     chker2(OCITransCommit_nb(svcctx, svcctx->base.hp.svc, oci8_errhp, OCI_DEFAULT), &svcctx->base);
+    oci8_free_temp_lobs(svcctx);
     return self;
 }
 
@@ -664,6 +869,7 @@ static VALUE oci8_rollback(VALUE self)
 {
     oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
     chker2(OCITransRollback_nb(svcctx, svcctx->base.hp.svc, oci8_errhp, OCI_DEFAULT), &svcctx->base);
+    oci8_free_temp_lobs(svcctx);
     return self;
 }
 
@@ -705,6 +911,68 @@ static VALUE oci8_set_non_blocking(VALUE self, VALUE val)
     return val;
 }
 
+/*
+ * @overload async_mode?
+ *
+ *  Returns +true+ if the connection is in async mode, +false+
+ *  otherwise.
+ *
+ *  @see #async_mode=
+ *  @since 2.2.15
+ */
+static VALUE oci8_async_mode_p(VALUE self)
+{
+    oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
+    return svcctx->async_mode ? Qtrue : Qfalse;
+}
+
+/*
+ * @overload async_mode=(async_mode)
+ *
+ *  Sets +true+ to enable async mode, +false+ otherwise.
+ *  The default value is +false+.
+ *
+ *  When the connection is in async mode and the current thread has
+ *  a fiber scheduler (ruby 3.0 or later), OCI calls such as
+ *  SQL executions, fetches, commits and LOB reads run in OCI
+ *  non-blocking mode. While the server is processing a call, the
+ *  fiber sleeps via the scheduler and other fibers in the thread
+ *  run. So one thread can keep queries in flight on several
+ *  connections. When the thread has no fiber scheduler, this has
+ *  no effect.
+ *
+ *  As OCI doesn't expose the socket of the connection, calls are
+ *  polled at intervals between 1 and 50 milliseconds.
+ *
+ *  @example
+ *    require 'async'
+ *    Async do
+ *      conns.each do |conn|
+ *        conn.async_mode = true
+ *        Async do
+ *          conn.exec('...')
+ *        end
+ *      end
+ *    end
+ *
+ *  @param [Boolean] async_mode
+ *  @raise [NotImplementedError] when ruby doesn't support fiber schedulers.
+ *  @since 2.2.15
+ */
+static VALUE oci8_set_async_mode(VALUE self, VALUE val)
+{
+    oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
+#ifdef HAVE_RB_FIBER_SCHEDULER_CURRENT
+    svcctx->async_mode = RTEST(val);
+#else
+    if (RTEST(val)) {
+        rb_raise(rb_eNotImpError, "async mode needs ruby 3.0 or later");
+    }
+    svcctx->async_mode = 0;
+#endif
+    return val;
+}
+
 /*
  * @overload autocommit?
  *
@@ -767,6 +1035,81 @@ static VALUE oci8_set_long_read_len(VALUE self, VALUE val)
     return val;
 }
 
+/*
+ * @overload temp_lob_free_threshold
+ *
+ *  Returns the number of garbage-collected temporary LOBs kept
+ *  without being freed.
+ *
+ *  @return [Integer]
+ *  @see #temp_lob_free_threshold=
+ *  @since 2.2.15
+ */
+static VALUE oci8_temp_lob_free_threshold(VALUE self)
+{
+    oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
+    return UINT2NUM(svcctx->temp_lob_free_threshold);
+}
+
+/*
+ * @overload temp_lob_free_threshold=(num)
+ *
+ *  Sets the number of garbage-collected temporary LOBs kept without
+ *  being freed. The default value is zero.
+ *
+ *  Temporary LOBs are freed on the server side by one round trip per
+ *  LOB. When they are garbage-collected, they are freed at once just
+ *  before the next server call by default. When this is set, they are
+ *  queued until the number exceeds +num+, the transaction is committed
+ *  or rolled back or {#free_temp_lobs} is called. So the next
+ *  unrelated query isn't delayed by freeing many temporary LOBs.
+ *
+ *  @param [Integer] num
+ *  @see #pending_temp_lobs
+ *  @since 2.2.15
+ */
+static VALUE oci8_set_temp_lob_free_threshold(VALUE self, VALUE val)
+{
+    oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
+    svcctx->temp_lob_free_threshold = NUM2UINT(val);
+    return val;
+}
+
+/*
+ * @overload pending_temp_lobs
+ *
+ *  Returns the number of garbage-collected temporary LOBs which
+ *  are not freed yet.
+ *
+ *  @return [Integer]
+ *  @see #temp_lob_free_threshold=
+ *  @since 2.2.15
+ */
+static VALUE oci8_pending_temp_lobs(VALUE self)
+{
+    oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
+    return UINT2NUM(svcctx->num_temp_lobs);
+}
+
+/*
+ * @overload free_temp_lobs
+ *
+ *  Frees garbage-collected temporary LOBs queued by
+ *  {#temp_lob_free_threshold=} now. Call this when the connection
+ *  is idle.
+ *
+ *  @return [Integer] the number of temporary LOBs freed
+ *  @since 2.2.15
+ */
+static VALUE oci8_free_temp_lobs_now(VALUE self)
+{
+    oci8_svcctx_t *svcctx = oci8_get_svcctx(self);
+    ub4 num = svcctx->num_temp_lobs;
+
+    oci8_free_temp_lobs(svcctx);
+    return UINT2NUM(num - svcctx->num_temp_lobs);
+}
+
 /*
  * @overload break
  *
@@ -789,6 +1132,13 @@ static VALUE oci8_break(VALUE self)
     if (NIL_P(svcctx->executing_thread)) {
         return Qfalse;
     }
+    if (svcctx->executing_async) {
+        /* The call is polled in OCI non-blocking mode. It returns
+         * ORA-01013 at the next poll.
+         */
+        OCIBreak(svcctx->base.hp.ptr, oci8_errhp);
+        return Qtrue;
+    }
     rb_thread_wakeup(svcctx->executing_thread);
     return Qtrue;
 }
@@ -1019,15 +1369,23 @@ void Init_oci8(VALUE *out)
     rb_define_private_method(cOCI8, "allocate_handles", oci8_allocate_handles, 0);
     rb_define_private_method(cOCI8, "server_attach", oci8_server_attach, 2);
     rb_define_private_method(cOCI8, "session_begin", oci8_session_begin, 2);
-    rb_define_method(cOCI8, "logoff", oci8_svcctx_logoff, 0);
+    rb_define_private_method(cOCI8, "session_get", oci8_session_get, 7);
+    rb_define_private_method(cOCI8, "set_release_tag", oci8_set_release_tag, 1);
+    rb_define_private_method(cOCI8, "__logoff", oci8_svcctx_logoff, 0);
     rb_define_method(cOCI8, "commit", oci8_commit, 0);
     rb_define_method(cOCI8, "rollback", oci8_rollback, 0);
     rb_define_method(cOCI8, "non_blocking?", oci8_non_blocking_p, 0);
     rb_define_method(cOCI8, "non_blocking=", oci8_set_non_blocking, 1);
+    rb_define_method(cOCI8, "async_mode?", oci8_async_mode_p, 0);
+    rb_define_method(cOCI8, "async_mode=", oci8_set_async_mode, 1);
     rb_define_method(cOCI8, "autocommit?", oci8_autocommit_p, 0);
     rb_define_method(cOCI8, "autocommit=", oci8_set_autocommit, 1);
     rb_define_method(cOCI8, "long_read_len", oci8_long_read_len, 0);
     rb_define_method(cOCI8, "long_read_len=", oci8_set_long_read_len, 1);
+    rb_define_method(cOCI8, "temp_lob_free_threshold", oci8_temp_lob_free_threshold, 0);
+    rb_define_method(cOCI8, "temp_lob_free_threshold=", oci8_set_temp_lob_free_threshold, 1);
+    rb_define_method(cOCI8, "pending_temp_lobs", oci8_pending_temp_lobs, 0);
+    rb_define_method(cOCI8, "free_temp_lobs", oci8_free_temp_lobs_now, 0);
     rb_define_method(cOCI8, "break", oci8_break, 0);
     rb_define_private_method(cOCI8, "oracle_server_vernum", oci8_oracle_server_vernum, 0);
     rb_define_method(cOCI8, "ping", oci8_ping, 0);
@@ -236,6 +236,8 @@ struct oci8_bind {
         void **null_structs;
         sb2 *inds;
     } u;
+    ub1 get_type; /* whether 'get' is overridden in ruby. See oci8_bind_get_at(). */
+    ub1 set_type; /* whether 'set' is overridden in ruby. See oci8_bind_set_at(). */
 };
 
 typedef struct oci8_logoff_strategy oci8_logoff_strategy_t;
@@ -259,6 +261,12 @@ typedef struct oci8_svcctx {
     char non_blocking;
     VALUE long_read_len;
     oci8_temp_lob_t *temp_lobs;
+    ub4 num_temp_lobs; /* the number of LOBs in temp_lobs */
+    ub4 temp_lob_free_threshold;
+    char async_mode;
+    char executing_async; /* polling a call in OCI non-blocking mode */
+    OraText *spool_tag; /* tag passed to OCISessionRelease() */
+    ub4 spool_tag_len;
 } oci8_svcctx_t;
 
 struct oci8_logoff_strategy {
@@ -332,7 +340,9 @@ VALUE oci8_define_class_under(VALUE outer, const char *name, const oci8_handle_d
 VALUE oci8_define_bind_class(const char *name, const oci8_bind_data_type_t *data_type, VALUE (*alloc_func)(VALUE));
 void oci8_link_to_parent(oci8_base_t *base, oci8_base_t *parent);
 void oci8_unlink_from_parent(oci8_base_t *base);
+void oci8_free_temp_lobs(oci8_svcctx_t *svcctx);
 sword oci8_call_without_gvl(oci8_svcctx_t *svcctx, void *(*func)(void *), void *data);
+sword oci8_call_nb(oci8_svcctx_t *svcctx, void *(*func)(void *), void *data);
 sword oci8_exec_sql(oci8_svcctx_t *svcctx, const char *sql_text, ub4 num_define_vars, oci8_exec_sql_var_t *define_vars, ub4 num_bind_vars, oci8_exec_sql_var_t *bind_vars, int raise_on_error);
 #if defined RUNTIME_API_CHECK
 void *oci8_find_symbol(const char *symbol_name);
@@ -347,6 +357,8 @@ NORETURN(void oci8_do_raise(OCIError *errhp, sword status, OCIStmt *stmthp, cons
 NORETURN(void oci8_do_env_raise(OCIEnv *envhp, sword status, int free_envhp, const char *file, int line));
 NORETURN(void oci8_do_raise_init_error(const char *file, int line));
 sb4 oci8_get_error_code(OCIError *errhp);
+#define oci8_make_ocierror(errhp, stmthp) oci8_do_make_ocierror(errhp, stmthp, __FILE__, __LINE__)
+VALUE oci8_do_make_ocierror(OCIError *errhp, OCIStmt *stmthp, const char *file, int line);
 VALUE oci8_get_error_message(ub4 msgno, const char *default_msg);
 NORETURN(void oci8_do_raise_by_msgno(ub4 msgno, const char *default_msg, const char *file, int line));
 void oci8_check_error_(sword status, oci8_base_t *base, OCIStmt *stmthp, const char *file, int line);
@@ -369,6 +381,9 @@ void oci8_check_pid_consistency(oci8_svcctx_t *svcctx);
 /* connection_pool.c */
 void Init_oci8_connection_pool(VALUE cOCI8);
 
+/* session_pool.c */
+void Init_oci8_session_pool(VALUE cOCI8);
+
 /* stmt.c */
 void Init_oci8_stmt(VALUE cOCI8);
 
@@ -380,6 +395,8 @@ typedef struct {
 extern const oci8_handle_data_type_t oci8_bind_data_type;
 void oci8_bind_free(oci8_base_t *base);
 void oci8_bind_hp_obj_mark(oci8_base_t *base);
+VALUE oci8_bind_get_at(oci8_bind_t *obind, ub4 idx);
+void oci8_bind_set_at(oci8_bind_t *obind, ub4 idx, VALUE val);
 void Init_oci8_bind(VALUE cOCI8BindTypeBase);
 
 /* metadata.c */
@@ -7,6 +7,9 @@
 #ifdef HAVE_RUBY_THREAD_H
 #include <ruby/thread.h>
 #endif
+#ifdef HAVE_RB_FIBER_SCHEDULER_CURRENT
+#include <ruby/fiber/scheduler.h>
+#endif
 #if defined(HAVE_PLTHOOK) && !defined(WIN32)
 #include <dlfcn.h>
 #include <sys/mman.h>
@@ -267,6 +270,9 @@ Init_oci8lib(void)
     /* OCI8::ConnectionPool class */
     Init_oci8_connection_pool(cOCI8);
 
+    /* OCI8::SessionPool class */
+    Init_oci8_session_pool(cOCI8);
+
     /* OCI8::BindType module */
     mOCI8BindType = rb_define_module_under(cOCI8, "BindType");
     /* OCI8::BindType::Base class */
@@ -384,20 +390,25 @@ static void oci8_unblock_func(void *user_data)
     OCIBreak(svcctx->base.hp.ptr, oci8_errhp);
 }
 
-typedef struct free_temp_lob_arg_t {
+typedef struct free_temp_lobs_arg_t {
     oci8_svcctx_t *svcctx;
     OCISvcCtx *svchp;
     OCIError *errhp;
-    OCILobLocator *lob;
-} free_temp_lob_arg_t;
+    oci8_temp_lob_t *lobs;
+    ub4 num_freed;
+} free_temp_lobs_arg_t;
 
-static void *free_temp_lob(void *user_data)
+static void *free_temp_lobs(void *user_data)
 {
-    free_temp_lob_arg_t *data = (free_temp_lob_arg_t *)user_data;
-    sword rv = OCILobFreeTemporary(data->svchp, data->errhp, data->lob);
+    free_temp_lobs_arg_t *data = (free_temp_lobs_arg_t *)user_data;
+    oci8_temp_lob_t *lob;
 
+    for (lob = data->lobs; lob != NULL; lob = lob->next) {
+        OCILobFreeTemporary(data->svchp, data->errhp, lob->lob);
+        data->num_freed++;
+    }
     data->svcctx->executing_thread = Qnil;
-    return (void*)(VALUE)rv;
+    return (void*)(VALUE)OCI_SUCCESS;
 }
 
 typedef struct protected_call_arg {
@@ -428,45 +439,76 @@ static VALUE protected_call(VALUE data)
     return rv;
 }
 
-sword oci8_call_without_gvl(oci8_svcctx_t *svcctx, void *(*func)(void *), void *data)
+/*
+ * Frees temporary LOBs queued by the garbage collector.
+ * All of them are freed in a function call running without the GVL
+ * instead of calling a function per LOB.
+ */
+void oci8_free_temp_lobs(oci8_svcctx_t *svcctx)
 {
-    OCIError *errhp = oci8_errhp;
-    protected_call_arg_t parg;
-    sword rv;
-    int state;
+    free_temp_lobs_arg_t arg;
+    oci8_temp_lob_t *lob;
+    ub4 idx;
 
-    if (!NIL_P(svcctx->executing_thread)) {
-        rb_raise(rb_eRuntimeError, "executing in another thread");
+    if (svcctx->suppress_free_temp_lobs || svcctx->temp_lobs == NULL) {
+        return;
     }
-    if (!svcctx->suppress_free_temp_lobs) {
-        oci8_temp_lob_t *lob;
-        while ((lob = svcctx->temp_lobs) != NULL) {
-            svcctx->temp_lobs = lob->next;
-
-            if (svcctx->non_blocking) {
-                free_temp_lob_arg_t arg;
-
-                arg.svcctx = svcctx;
-                arg.svchp = svcctx->base.hp.svc;
-                arg.errhp = errhp;
-                arg.lob = lob->lob;
+    arg.svcctx = svcctx;
+    arg.svchp = svcctx->base.hp.svc;
+    arg.errhp = oci8_errhp;
+    arg.lobs = svcctx->temp_lobs;
+    arg.num_freed = 0;
+    svcctx->temp_lobs = NULL;
+    svcctx->num_temp_lobs = 0;
 
-                parg.svcctx = svcctx;
-                parg.func = free_temp_lob;
-                parg.data = &arg;
+    if (svcctx->non_blocking) {
+        protected_call_arg_t parg;
+        int state;
 
-                rb_protect(protected_call, (VALUE)&parg, &state);
-                if (state) {
+        if (!NIL_P(svcctx->executing_thread)) {
+            rb_raise(rb_eRuntimeError, "executing in another thread");
+        }
+        parg.svcctx = svcctx;
+        parg.func = free_temp_lobs;
+        parg.data = &arg;
+        rb_protect(protected_call, (VALUE)&parg, &state);
+        RB_OBJ_WRITE(svcctx->base.self, &svcctx->executing_thread, Qnil);
+        if (state) {
+            /* queue LOBs not freed again. */
+            for (idx = 0; (lob = arg.lobs) != NULL; idx++) {
+                arg.lobs = lob->next;
+                if (idx < arg.num_freed) {
+                    OCIDescriptorFree(lob->lob, OCI_DTYPE_LOB);
+                    xfree(lob);
+                } else {
                     lob->next = svcctx->temp_lobs;
                     svcctx->temp_lobs = lob;
-                    rb_jump_tag(state);
+                    svcctx->num_temp_lobs++;
                 }
-            } else {
-                OCILobFreeTemporary(svcctx->base.hp.svc, errhp, lob->lob);
             }
-            OCIDescriptorFree(lob->lob, OCI_DTYPE_LOB);
-            xfree(lob);
+            rb_jump_tag(state);
         }
+    } else {
+        free_temp_lobs(&arg);
+    }
+    while ((lob = arg.lobs) != NULL) {
+        arg.lobs = lob->next;
+        OCIDescriptorFree(lob->lob, OCI_DTYPE_LOB);
+        xfree(lob);
+    }
+}
+
+sword oci8_call_without_gvl(oci8_svcctx_t *svcctx, void *(*func)(void *), void *data)
+{
+    protected_call_arg_t parg;
+    sword rv;
+    int state;
+
+    if (!NIL_P(svcctx->executing_thread)) {
+        rb_raise(rb_eRuntimeError, "executing in another thread");
+    }
+    if (svcctx->num_temp_lobs > svcctx->temp_lob_free_threshold) {
+        oci8_free_temp_lobs(svcctx);
     }
 
     if (svcctx->non_blocking) {
@@ -484,6 +526,121 @@ sword oci8_call_without_gvl(oci8_svcctx_t *svcctx, void *(*func)(void *), void *
     }
 }
 
+#ifdef HAVE_RB_FIBER_SCHEDULER_CURRENT
+/* intervals in seconds to poll an OCI call in OCI non-blocking mode */
+#define ASYNC_POLL_MIN_INTERVAL 0.001
+#define ASYNC_POLL_MAX_INTERVAL 0.05
+
+typedef struct {
+    oci8_svcctx_t *svcctx;
+    OCIServer *srvhp;
+    void *(*func)(void *);
+    void *data;
+    sword rv;
+} async_call_arg_t;
+
+/*
+ * Sets OCI non-blocking mode of the server handle.
+ * OCIAttrSet() with OCI_ATTR_NONBLOCKING_MODE toggles the mode.
+ */
+static sword set_oci_nonblocking_mode(OCIServer *srvhp, int on)
+{
+    ub1 mode = 0;
+    sword rv;
+
+    rv = OCIAttrGet(srvhp, OCI_HTYPE_SERVER, &mode, 0, OCI_ATTR_NONBLOCKING_MODE, oci8_errhp);
+    if (rv == OCI_SUCCESS && (mode != 0) != (on != 0)) {
+        rv = OCIAttrSet(srvhp, OCI_HTYPE_SERVER, 0, 0, OCI_ATTR_NONBLOCKING_MODE, oci8_errhp);
+    }
+    return rv;
+}
+
+static VALUE async_call(VALUE varg)
+{
+    async_call_arg_t *arg = (async_call_arg_t *)varg;
+    oci8_svcctx_t *svcctx = arg->svcctx;
+    VALUE scheduler = rb_fiber_scheduler_current();
+    double interval = ASYNC_POLL_MIN_INTERVAL;
+
+    chker2(OCIAttrGet(svcctx->base.hp.ptr, OCI_HTYPE_SVCCTX, &arg->srvhp, 0, OCI_ATTR_SERVER, oci8_errhp),
+           &svcctx->base);
+    chker2(set_oci_nonblocking_mode(arg->srvhp, 1), &svcctx->base);
+    /* OCI doesn't expose the socket of the session. The call is polled
+     * with exponential backoff instead of waiting for the socket.
+     */
+    while ((arg->rv = (sword)(VALUE)arg->func(arg->data)) == OCI_STILL_EXECUTING) {
+        rb_fiber_scheduler_kernel_sleep(scheduler, rb_float_new(interval));
+        interval *= 2;
+        if (interval > ASYNC_POLL_MAX_INTERVAL) {
+            interval = ASYNC_POLL_MAX_INTERVAL;
+        }
+    }
+    if (arg->rv == OCI_ERROR) {
+        if (oci8_get_error_code(oci8_errhp) == 1013) {
+            /* canceled by OCI8#break */
+            OCIReset(svcctx->base.hp.ptr, oci8_errhp);
+            rb_raise(eOCIBreak, "Canceled by user request.");
+        }
+    }
+    return Qnil;
+}
+
+static VALUE async_call_ensure(VALUE varg)
+{
+    async_call_arg_t *arg = (async_call_arg_t *)varg;
+    oci8_svcctx_t *svcctx = arg->svcctx;
+
+    if (arg->rv == OCI_STILL_EXECUTING) {
+        /* An exception was raised while the fiber was waiting.
+         * Cancel the call to use the connection later.
+         */
+        OCIBreak(svcctx->base.hp.ptr, oci8_errhp);
+        OCIReset(svcctx->base.hp.ptr, oci8_errhp);
+    }
+    if (arg->srvhp != NULL) {
+        set_oci_nonblocking_mode(arg->srvhp, 0);
+    }
+    svcctx->executing_async = 0;
+    RB_OBJ_WRITE(svcctx->base.self, &svcctx->executing_thread, Qnil);
+    return Qnil;
+}
+#endif
+
+/*
+ * Calls an OCI function which may be called again with same arguments
+ * until it finishes.
+ *
+ * When the connection is in async mode and the current thread has a
+ * fiber scheduler, the function is called in OCI non-blocking mode
+ * and other fibers run while it returns OCI_STILL_EXECUTING.
+ * Otherwise, this is same with oci8_call_without_gvl().
+ */
+sword oci8_call_nb(oci8_svcctx_t *svcctx, void *(*func)(void *), void *data)
+{
+#ifdef HAVE_RB_FIBER_SCHEDULER_CURRENT
+    if (svcctx->async_mode && !NIL_P(rb_fiber_scheduler_current())) {
+        async_call_arg_t arg;
+
+        if (!NIL_P(svcctx->executing_thread)) {
+            rb_raise(rb_eRuntimeError, "executing in another thread");
+        }
+        if (svcctx->num_temp_lobs > svcctx->temp_lob_free_threshold) {
+            oci8_free_temp_lobs(svcctx);
+        }
+        arg.svcctx = svcctx;
+        arg.srvhp = NULL;
+        arg.func = func;
+        arg.data = data;
+        arg.rv = OCI_SUCCESS;
+        RB_OBJ_WRITE(svcctx->base.self, &svcctx->executing_thread, rb_thread_current());
+        svcctx->executing_async = 1;
+        rb_ensure(async_call, (VALUE)&arg, async_call_ensure, (VALUE)&arg);
+        return arg.rv;
+    }
+#endif
+    return oci8_call_without_gvl(svcctx, func, data);
+}
+
 typedef struct {
     oci8_svcctx_t *svcctx;
     const char *sql_text;
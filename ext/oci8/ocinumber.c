@@ -24,6 +24,8 @@ static ID id_split;
 static ID id_numerator;
 static ID id_denominator;
 static ID id_BigDecimal;
+static ID id_int64;
+static ID id_double;
 
 static VALUE cBigDecimal;
 
@@ -117,10 +119,14 @@ VALUE oci8_make_ocinumber(OCINumber *s, OCIError *errhp)
  */
 VALUE oci8_make_integer(OCINumber *s, OCIError *errhp)
 {
+    LONG_LONG ll;
     signed long sl;
     char buf[512];
     sword rv;
 
+    if (oranumber_to_int64(s, &ll) == ORANUMBER_SUCCESS) {
+        return LL2NUM(ll);
+    }
     if (OCINumberToInt(errhp, s, sizeof(sl), OCI_NUMBER_SIGNED, &sl) == OCI_SUCCESS) {
         return LONG2NUM(sl);
     }
@@ -320,8 +326,13 @@ double oci8_onum_to_dbl(OCINumber *s, OCIError *errhp)
 {
     if (oci8_float_conversion_type_is_ruby) {
         char buf[256];
+        double dbl;
         sword rv;
 
+        /* decode directly when the result is same with rb_cstr_to_dbl(). */
+        if (oranumber_to_double(s, &dbl) == ORANUMBER_SUCCESS) {
+            return dbl;
+        }
         rv = oranumber_to_str(s, buf, sizeof(buf));
         if (rv <= 0) {
             char buf[ORANUMBER_DUMP_BUF_SIZ];
@@ -1778,12 +1789,214 @@ static VALUE bind_float_alloc(VALUE klass)
     return oci8_allocate_typeddata(klass, &bind_float_data_type.base);
 }
 
+/*
+ * @overload get_packed_data(type, index, num_rows, values = nil, nulls = nil)
+ *
+ *  Converts <i>num_rows</i> values from the <i>index</i>-th element
+ *  to a packed binary string at once without creating ruby objects
+ *  per value.
+ *
+ *  When <i>type</i> is +:int64+, each value is packed as a 64-bit
+ *  signed integer in native byte order, which is read by
+ *  <code>String#unpack('q*')</code>. When it is +:double+, it is packed
+ *  as a double, which is read by <code>String#unpack('d*')</code>.
+ *  NULL values are packed as zero.
+ *
+ *  It returns a pair of the packed values and a null bitmap. The
+ *  n-th bit (LSB first) of the bitmap is set when the n-th value is
+ *  NULL. When <i>values</i> and <i>nulls</i> are passed, the values
+ *  and bits are appended to them.
+ *
+ *  @example
+ *    values, nulls = bindobj.get_packed_data(:double, 0, 100)
+ *    values.unpack('d*') # => 100 floats
+ *    nulls.unpack('b*')[0][5] # => '1' if the 6th value is NULL.
+ *
+ *  @param [Symbol] type     +:int64+ or +:double+
+ *  @param [Integer] index   index of the first element
+ *  @param [Integer] num_rows number of elements
+ *  @param [String] values   string to which the packed values are appended
+ *  @param [String] nulls    null bitmap to which the bits are appended
+ *  @return [Array] a pair of the packed values and the null bitmap
+ *
+ *  @since 2.2.15
+ */
+static VALUE bind_number_get_packed_data(int argc, VALUE *argv, VALUE self)
+{
+    oci8_bind_t *obind = TO_BIND(self);
+    OCIError *errhp = oci8_errhp;
+    VALUE type, index, num_rows, values, nulls;
+    ID type_id;
+    ub4 idx, nrows, offset, i;
+    OCINumber *num;
+    VALUE tmp;
+    char *valp;
+    unsigned char *flagp;
+    unsigned char *nullp;
+
+    rb_scan_args(argc, argv, "32", &type, &index, &num_rows, &values, &nulls);
+    type_id = rb_to_id(type);
+    if (type_id != id_int64 && type_id != id_double) {
+        rb_raise(rb_eArgError, "invalid type %s (expect :int64 or :double)", rb_id2name(type_id));
+    }
+    idx = NUM2UINT(index);
+    nrows = NUM2UINT(num_rows);
+    if (idx > obind->maxar_sz || nrows > obind->maxar_sz - idx) {
+        if (!(obind->maxar_sz == 0 && idx == 0 && nrows <= 1)) {
+            rb_raise(rb_eRuntimeError, "data index is too big. (%u + %u for %u)", idx, nrows, obind->maxar_sz);
+        }
+    }
+    if (NIL_P(values)) {
+        values = rb_str_buf_new(nrows * 8);
+        nulls = rb_str_buf_new((nrows + 7) / 8);
+    } else {
+        StringValue(values);
+        StringValue(nulls);
+        rb_str_modify(values);
+        rb_str_modify(nulls);
+    }
+    if (RSTRING_LEN(values) % 8 != 0 || RSTRING_LEN(nulls) != (RSTRING_LEN(values) / 8 + 7) / 8) {
+        rb_raise(rb_eArgError, "inconsistent length of values and nulls");
+    }
+    offset = (ub4)(RSTRING_LEN(values) / 8);
+
+    /* Convert values to a temporary buffer first not to leave
+     * <values> and <nulls> half-updated when a conversion fails.
+     * The buffer consists of <nrows> packed values followed by
+     * <nrows> null flags.
+     */
+    tmp = rb_str_new(NULL, (long)nrows * 9);
+    valp = RSTRING_PTR(tmp);
+    flagp = (unsigned char *)RSTRING_PTR(tmp) + (long)nrows * 8;
+    num = (OCINumber *)obind->valuep + idx;
+    for (i = 0; i < nrows; i++, num++, valp += 8) {
+        if (obind->u.inds[idx + i] != 0) {
+            flagp[i] = 1;
+            memset(valp, 0, 8);
+        } else if (type_id == id_int64) {
+            LONG_LONG ll;
+
+            if (oranumber_to_int64(num, &ll) != ORANUMBER_SUCCESS) {
+                chkerr(OCINumberToInt(errhp, num, sizeof(ll), OCI_NUMBER_SIGNED, &ll));
+            }
+            flagp[i] = 0;
+            memcpy(valp, &ll, 8);
+        } else {
+            double dbl = oci8_onum_to_dbl(num, errhp);
+            flagp[i] = 0;
+            memcpy(valp, &dbl, 8);
+        }
+    }
+
+    rb_str_resize(values, (offset + nrows) * 8);
+    rb_str_resize(nulls, (offset + nrows + 7) / 8);
+    memcpy(RSTRING_PTR(values) + offset * 8, RSTRING_PTR(tmp), (size_t)nrows * 8);
+    nullp = (unsigned char *)RSTRING_PTR(nulls);
+    /* clear unused bits in the last byte and new bytes */
+    if (offset % 8 != 0) {
+        nullp[offset / 8] &= (1u << (offset % 8)) - 1;
+    }
+    memset(nullp + (offset + 7) / 8, 0, (offset + nrows + 7) / 8 - (offset + 7) / 8);
+    for (i = 0; i < nrows; i++) {
+        if (flagp[i]) {
+            ub4 bit = offset + i;
+            nullp[bit / 8] |= 1u << (bit % 8);
+        }
+    }
+    RB_GC_GUARD(tmp);
+    return rb_assoc_new(values, nulls);
+}
+
+/*
+ * @overload set_packed_data(type, values, nulls = nil)
+ *
+ *  Sets elements from a packed binary string at once without
+ *  creating ruby objects per value. This is the reverse of
+ *  {#get_packed_data}.
+ *
+ *  When <i>type</i> is +:int64+, <i>values</i> is read as 64-bit
+ *  signed integers in native byte order, which are made by
+ *  <code>Array#pack('q*')</code>. When it is +:double+, it is read as
+ *  doubles, which are made by <code>Array#pack('d*')</code>.
+ *  The n-th value is set to NULL when the n-th bit (LSB first)
+ *  of <i>nulls</i> is set.
+ *
+ *  @example
+ *    bindobj.set_packed_data(:int64, [1, 2, 3].pack('q*'))
+ *    bindobj.set_packed_data(:double, [1.5, 0.0].pack('d*'), ['01'].pack('b*')) # [1.5, nil]
+ *
+ *  @param [Symbol] type     +:int64+ or +:double+
+ *  @param [String] values   packed values
+ *  @param [String] nulls    null bitmap
+ *  @return [Integer] the number of elements set
+ *
+ *  @since 2.2.15
+ */
+static VALUE bind_number_set_packed_data(int argc, VALUE *argv, VALUE self)
+{
+    oci8_bind_t *obind = TO_BIND(self);
+    OCIError *errhp = oci8_errhp;
+    VALUE type, values, nulls;
+    ID type_id;
+    ub4 nrows, maxrows, i;
+    OCINumber *num;
+    const char *valp;
+    const unsigned char *nullp = NULL;
+
+    rb_scan_args(argc, argv, "21", &type, &values, &nulls);
+    type_id = rb_to_id(type);
+    if (type_id != id_int64 && type_id != id_double) {
+        rb_raise(rb_eArgError, "invalid type %s (expect :int64 or :double)", rb_id2name(type_id));
+    }
+    StringValue(values);
+    if (RSTRING_LEN(values) % 8 != 0) {
+        rb_raise(rb_eArgError, "invalid length of values");
+    }
+    nrows = (ub4)(RSTRING_LEN(values) / 8);
+    maxrows = obind->maxar_sz ? obind->maxar_sz : 1;
+    if (nrows > maxrows) {
+        rb_raise(rb_eRuntimeError, "over the max array size");
+    }
+    if (!NIL_P(nulls)) {
+        StringValue(nulls);
+        if (RSTRING_LEN(nulls) < (long)(nrows + 7) / 8) {
+            rb_raise(rb_eArgError, "null bitmap is too short");
+        }
+        nullp = (const unsigned char *)RSTRING_PTR(nulls);
+    }
+    valp = RSTRING_PTR(values);
+    num = (OCINumber *)obind->valuep;
+    for (i = 0; i < nrows; i++, num++, valp += 8) {
+        if (nullp != NULL && (nullp[i / 8] & (1u << (i % 8)))) {
+            obind->u.inds[i] = -1;
+            continue;
+        }
+        obind->u.inds[i] = 0;
+        if (type_id == id_int64) {
+            LONG_LONG ll;
+
+            memcpy(&ll, valp, 8);
+            chkerr(OCINumberFromInt(errhp, &ll, sizeof(ll), OCI_NUMBER_SIGNED, num));
+        } else {
+            double dbl;
+
+            memcpy(&dbl, valp, 8);
+            chkerr(OCINumberFromReal(errhp, &dbl, sizeof(dbl), num));
+        }
+    }
+    if (obind->maxar_sz != 0) {
+        obind->curar_sz = nrows;
+    }
+    return UINT2NUM(nrows);
+}
+
 void
 Init_oci_number(VALUE cOCI8, OCIError *errhp)
 {
     VALUE mMath;
     OCINumber num1, num2;
     VALUE obj_PI;
+    VALUE klass;
     signed long sl;
 
     id_power = rb_intern("**");
@@ -1889,9 +2102,17 @@ Init_oci_number(VALUE cOCI8, OCIError *errhp)
     rb_define_method(cOCINumber, "_dump", onum__dump, -1);
     rb_define_singleton_method(cOCINumber, "_load", onum_s_load, 1);
 
-    oci8_define_bind_class("OraNumber", &bind_ocinumber_data_type, bind_ocinumber_alloc);
-    oci8_define_bind_class("Integer", &bind_integer_data_type, bind_integer_alloc);
-    oci8_define_bind_class("Float", &bind_float_data_type, bind_float_alloc);
+    id_int64 = rb_intern("int64");
+    id_double = rb_intern("double");
+    klass = oci8_define_bind_class("OraNumber", &bind_ocinumber_data_type, bind_ocinumber_alloc);
+    rb_define_method(klass, "get_packed_data", bind_number_get_packed_data, -1);
+    rb_define_method(klass, "set_packed_data", bind_number_set_packed_data, -1);
+    klass = oci8_define_bind_class("Integer", &bind_integer_data_type, bind_integer_alloc);
+    rb_define_method(klass, "get_packed_data", bind_number_get_packed_data, -1);
+    rb_define_method(klass, "set_packed_data", bind_number_set_packed_data, -1);
+    klass = oci8_define_bind_class("Float", &bind_float_data_type, bind_float_alloc);
+    rb_define_method(klass, "get_packed_data", bind_number_get_packed_data, -1);
+    rb_define_method(klass, "set_packed_data", bind_number_set_packed_data, -1);
 
 #if 0 /* for rdoc/yard */
     oci8_cOCIHandle = rb_define_class("OCIHandle", rb_cObject);
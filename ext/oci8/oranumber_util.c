@@ -1,8 +1,15 @@
 /* -*- c-file-style: "ruby"; indent-tabs-mode: nil -*- */
 #include <stdio.h>
 #include <string.h>
+#include <float.h>
+#include <math.h>
 #include "oranumber_util.h"
 
+/* return values of decode_mantissa() other than the number of digits. */
+#define DECODED_ZERO -10
+#define DECODED_POSITIVE_INFINITY -11
+#define DECODED_NEGATIVE_INFINITY -12
+
 int oranumber_to_str(const OCINumber *on, char *buf, int buflen)
 {
     signed char exponent;
@@ -334,6 +341,175 @@ int oranumber_from_str(OCINumber *on, const char *buf, int buflen)
     return ORANUMBER_SUCCESS;
 }
 
+/*
+ * Decodes an Oracle number to the sign, the exponent and base-100 digits.
+ * The number is (-1)^negative * sum(mantissa[i] * 100^(exponent - i)).
+ * It returns the number of digits, DECODED_* for special values or
+ * ORANUMBER_INVALID_INTERNAL_FORMAT.
+ */
+static int decode_mantissa(const OCINumber *on, int *negative, int *exponent, unsigned char *mantissa)
+{
+    int datalen = on->OCINumberPart[0];
+    int idx;
+
+    if (datalen == 1) {
+        if (on->OCINumberPart[1] == 0x80) {
+            return DECODED_ZERO;
+        }
+        if (on->OCINumberPart[1] == 0) {
+            return DECODED_NEGATIVE_INFINITY;
+        }
+        return ORANUMBER_INVALID_INTERNAL_FORMAT;
+    }
+    if (datalen == 2 && on->OCINumberPart[1] == 255 && on->OCINumberPart[2] == 101) {
+        return DECODED_POSITIVE_INFINITY;
+    }
+    if (datalen < 2 || datalen > 21) {
+        return ORANUMBER_INVALID_INTERNAL_FORMAT;
+    }
+    if (on->OCINumberPart[1] >= 128) {
+        /* positive number */
+        *negative = 0;
+        *exponent = on->OCINumberPart[1] - 193;
+        for (idx = 0; idx < datalen - 1; idx++) {
+            int n = on->OCINumberPart[idx + 2] - 1;
+            if (n < 0 || 99 < n) {
+                return ORANUMBER_INVALID_INTERNAL_FORMAT;
+            }
+            mantissa[idx] = n;
+        }
+    } else {
+        /* negative number */
+        *negative = 1;
+        *exponent = 62 - on->OCINumberPart[1];
+        for (idx = 0; idx < datalen - 1; idx++) {
+            int n = 101 - on->OCINumberPart[idx + 2];
+            if (n == -1) {
+                /* terminated by 102 */
+                break;
+            }
+            if (n < 0 || 99 < n) {
+                return ORANUMBER_INVALID_INTERNAL_FORMAT;
+            }
+            mantissa[idx] = n;
+        }
+    }
+    if (idx == 0) {
+        return ORANUMBER_INVALID_INTERNAL_FORMAT;
+    }
+    return idx;
+}
+
+int oranumber_to_int64(const OCINumber *on, long long *result)
+{
+    unsigned char mantissa[20];
+    int negative;
+    int exponent;
+    int ndigits = decode_mantissa(on, &negative, &exponent, mantissa);
+    unsigned long long limit;
+    unsigned long long val = 0;
+    int idx;
+
+    if (ndigits < 0) {
+        switch (ndigits) {
+        case DECODED_ZERO:
+            *result = 0;
+            return ORANUMBER_SUCCESS;
+        case ORANUMBER_INVALID_INTERNAL_FORMAT:
+            return ORANUMBER_INVALID_INTERNAL_FORMAT;
+        default:
+            return ORANUMBER_NOT_CONVERTIBLE;
+        }
+    }
+    if (exponent < ndigits - 1 || exponent >= 10) {
+        /* fractional number or larger than 100^10 */
+        return ORANUMBER_NOT_CONVERTIBLE;
+    }
+    /* 2^63 - 1 or 2^63 */
+    limit = negative ? 9223372036854775808ULL : 9223372036854775807ULL;
+    for (idx = 0; idx <= exponent; idx++) {
+        int n = (idx < ndigits) ? mantissa[idx] : 0;
+        if (val > (limit - n) / 100) {
+            return ORANUMBER_NOT_CONVERTIBLE;
+        }
+        val = val * 100 + n;
+    }
+    if (negative) {
+        *result = (val == 0) ? 0 : -(long long)(val - 1) - 1;
+    } else {
+        *result = (long long)val;
+    }
+    return ORANUMBER_SUCCESS;
+}
+
+/* powers of ten exactly representable by double */
+static const double exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+#define MAX_EXACT_POW10 22
+#define MAX_EXACT_INTEGER 9007199254740992ULL /* 2^53 */
+
+int oranumber_to_double(const OCINumber *on, double *result)
+{
+    unsigned char mantissa[20];
+    int negative;
+    int exponent;
+    int ndigits = decode_mantissa(on, &negative, &exponent, mantissa);
+    unsigned long long val = 0;
+    double dbl;
+    int exp10;
+    int idx;
+
+    if (ndigits < 0) {
+        switch (ndigits) {
+        case DECODED_ZERO:
+            *result = 0.0;
+            return ORANUMBER_SUCCESS;
+        case DECODED_POSITIVE_INFINITY:
+            *result = HUGE_VAL;
+            return ORANUMBER_SUCCESS;
+        case DECODED_NEGATIVE_INFINITY:
+            *result = -HUGE_VAL;
+            return ORANUMBER_SUCCESS;
+        default:
+            return ORANUMBER_INVALID_INTERNAL_FORMAT;
+        }
+    }
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+    /* Intermediate results may be rounded twice. */
+    return ORANUMBER_NOT_CONVERTIBLE;
+#endif
+    if (ndigits > 9) {
+        return ORANUMBER_NOT_CONVERTIBLE;
+    }
+    for (idx = 0; idx < ndigits; idx++) {
+        val = val * 100 + mantissa[idx];
+    }
+    exp10 = 2 * (exponent - ndigits + 1);
+    if (val % 10 == 0) {
+        val /= 10;
+        exp10++;
+    }
+    if (val > MAX_EXACT_INTEGER) {
+        return ORANUMBER_NOT_CONVERTIBLE;
+    }
+    /* Both val and 10^|exp10| are exact. The result of one multiplication
+     * or division is correctly rounded. This is the fast path of strtod()
+     * described by William D. Clinger.
+     */
+    if (0 <= exp10 && exp10 <= MAX_EXACT_POW10) {
+        dbl = (double)val * exact_pow10[exp10];
+    } else if (-MAX_EXACT_POW10 <= exp10 && exp10 < 0) {
+        dbl = (double)val / exact_pow10[-exp10];
+    } else {
+        return ORANUMBER_NOT_CONVERTIBLE;
+    }
+    *result = negative ? -dbl : dbl;
+    return ORANUMBER_SUCCESS;
+}
+
 int oranumber_dump(const OCINumber *on, char *buf)
 {
     int idx;
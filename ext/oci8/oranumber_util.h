@@ -10,6 +10,7 @@
 
 #define ORANUMBER_INVALID_INTERNAL_FORMAT -1
 #define ORANUMBER_TOO_SHORT_BUFFER -2
+#define ORANUMBER_NOT_CONVERTIBLE -3
 
 #define ORANUMBER_SUCCESS 0
 #define ORANUMBER_INVALID_NUMBER 1722
@@ -18,6 +19,12 @@
 int oranumber_to_str(const OCINumber *on, char *buf, int buflen);
 int oranumber_from_str(OCINumber *on, const char *buf, int buflen);
 
+/* They return ORANUMBER_NOT_CONVERTIBLE when the number cannot be
+ * converted exactly. Use oranumber_to_str() in the case.
+ */
+int oranumber_to_int64(const OCINumber *on, long long *result);
+int oranumber_to_double(const OCINumber *on, double *result);
+
 #define ORANUMBER_DUMP_BUF_SIZ 99
 int oranumber_dump(const OCINumber *on, char *buf);
 
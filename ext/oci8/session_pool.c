@@ -0,0 +1,441 @@
+/* -*- c-file-style: "ruby"; indent-tabs-mode: nil -*- */
+/*
+ * session_pool.c - part of ruby-oci8
+ *
+ * Copyright (C) 2024 Kubo Takehiro <kubo@jiubao.org>
+ *
+ */
+#include "oci8.h"
+#ifdef HAVE_RUBY_THREAD_H
+#include <ruby/thread.h>
+#endif
+
+#ifndef OCI_HTYPE_SPOOL
+#define OCI_HTYPE_SPOOL 27
+#endif
+#ifndef OCI_SPC_REINITIALIZE
+#define OCI_SPC_REINITIALIZE 0x0001
+#endif
+#ifndef OCI_SPC_HOMOGENEOUS
+#define OCI_SPC_HOMOGENEOUS 0x0002
+#endif
+#ifndef OCI_SPC_STMTCACHE
+#define OCI_SPC_STMTCACHE 0x0004
+#endif
+#ifndef OCI_SPD_FORCE
+#define OCI_SPD_FORCE 0x0001
+#endif
+#ifndef OCI_ATTR_SPOOL_BUSY_COUNT
+#define OCI_ATTR_SPOOL_BUSY_COUNT 310
+#endif
+#ifndef OCI_ATTR_SPOOL_MAX
+#define OCI_ATTR_SPOOL_MAX 313
+#endif
+#ifndef OCI_SESSGET_SPOOL
+#define OCI_SESSGET_SPOOL 0x0001
+#endif
+
+static VALUE cOCISessionPool;
+
+#define TO_SPOOL(obj) ((oci8_spool_t *)oci8_check_typeddata((obj), &oci8_spool_data_type, 1))
+
+typedef struct {
+    oci8_base_t base;
+    VALUE pool_name;
+    char homogeneous;
+} oci8_spool_t;
+
+static void oci8_spool_mark(oci8_base_t *base)
+{
+    oci8_spool_t *spool = (oci8_spool_t *)base;
+
+    rb_gc_mark(spool->pool_name);
+}
+
+static void *spool_free_thread(void *arg)
+{
+    OCISessionPoolDestroy((OCISPool *)arg, oci8_errhp, OCI_SPD_FORCE);
+    OCIHandleFree(arg, OCI_HTYPE_SPOOL);
+    return NULL;
+}
+
+static void oci8_spool_free(oci8_base_t *base)
+{
+    oci8_run_native_thread(spool_free_thread, base->hp.ptr);
+    base->type = 0;
+    base->closed = 1;
+    base->hp.ptr = NULL;
+}
+
+static const oci8_handle_data_type_t oci8_spool_data_type = {
+    {
+        "OCI8::SessionPool",
+        {
+            (RUBY_DATA_FUNC)oci8_spool_mark,
+            oci8_handle_cleanup,
+            oci8_handle_size,
+        },
+        &oci8_handle_data_type.rb_data_type, NULL,
+#ifdef RUBY_TYPED_WB_PROTECTED
+        RUBY_TYPED_WB_PROTECTED,
+#endif
+    },
+    oci8_spool_free,
+    sizeof(oci8_spool_t),
+};
+
+static VALUE oci8_spool_alloc(VALUE klass)
+{
+    VALUE self = oci8_allocate_typeddata(klass, &oci8_spool_data_type);
+    oci8_spool_t *spool = (oci8_spool_t *)RTYPEDDATA_DATA(self);
+
+    spool->pool_name = Qnil;
+    return self;
+}
+
+/*
+ * call-seq:
+ *   OCI8::SessionPool.new(sess_min, sess_max, sess_incr, username = nil, password = nil, dbname = nil) -> session pool
+ *   OCI8::SessionPool.new(sess_min, sess_max, sess_incr, connect_string) -> session pool
+ *
+ * Creates a session pool.
+ *
+ * <i>sess_min</i> specifies the minimum number of sessions in the
+ * session pool. The sessions are created when the pool is created.
+ *
+ * <i>sess_max</i> specifies the maximum number of sessions that
+ * can be opened in the session pool.
+ *
+ * <i>sess_incr</i> specifies the number of sessions created when
+ * the pool has no idle session and the number of sessions is less
+ * than <i>sess_max</i>.
+ *
+ * When <i>username</i> and <i>password</i> are specified, the pool
+ * is homogeneous. All sessions are authenticated by them and
+ * sessions are got by <code>OCI8.new(nil, nil, pool)</code>.
+ * When both are nil, sessions are authenticated by username and
+ * password passed to <code>OCI8.new</code>.
+ *
+ * <i>dbname</i> specifies the database server to connect to. Use a
+ * connect string with <code>(SERVER=POOLED)</code> for Database
+ * Resident Connection Pooling (DRCP).
+ *
+ * If the number of arguments is four, <i>username</i>,
+ * <i>password</i> and <i>dbname</i> are extracted from the fourth
+ * argument <i>connect_string</i>. The syntax is "username/password" or
+ * "username/password@dbname".
+ *
+ * Each session in the pool has its own statement cache.
+ *
+ * @since 2.2.15
+ */
+static VALUE oci8_spool_initialize(int argc, VALUE *argv, VALUE self)
+{
+    VALUE sess_min;
+    VALUE sess_max;
+    VALUE sess_incr;
+    VALUE username;
+    VALUE password;
+    VALUE dbname;
+    oci8_spool_t *spool = TO_SPOOL(self);
+    OraText *pool_name = NULL;
+    ub4 pool_name_len = 0;
+    ub4 mode = OCI_SPC_STMTCACHE;
+    sword rv;
+
+    /* check arguments */
+    rb_scan_args(argc, argv, "42", &sess_min, &sess_max, &sess_incr,
+                 &username, &password, &dbname);
+    Check_Type(sess_min, T_FIXNUM);
+    Check_Type(sess_max, T_FIXNUM);
+    Check_Type(sess_incr, T_FIXNUM);
+    if (argc == 4) {
+        VALUE privilege;
+        VALUE conn_str = username;
+
+        OCI8SafeStringValue(conn_str);
+        oci8_do_parse_connect_string(conn_str, &username, &password, &dbname, &privilege);
+        if (!NIL_P(privilege)) {
+            rb_raise(rb_eArgError, "invalid connect string \"%s\": Session pooling doesn't support sysdba and sysoper privileges.", RSTRING_PTR(conn_str));
+        }
+    } else {
+        if (!NIL_P(username)) {
+            OCI8SafeStringValue(username);
+        }
+        if (!NIL_P(password)) {
+            OCI8SafeStringValue(password);
+        }
+        if (!NIL_P(dbname)) {
+            OCI8SafeStringValue(dbname);
+        }
+    }
+    if (!NIL_P(username) || !NIL_P(password)) {
+        mode |= OCI_SPC_HOMOGENEOUS;
+        spool->homogeneous = 1;
+    }
+
+    rv = OCIHandleAlloc(oci8_envhp, &spool->base.hp.ptr, OCI_HTYPE_SPOOL, 0, NULL);
+    if (rv != OCI_SUCCESS)
+        oci8_env_raise(oci8_envhp, rv);
+    spool->base.type = OCI_HTYPE_SPOOL;
+
+    chker2(OCISessionPoolCreate(oci8_envhp, oci8_errhp, spool->base.hp.ptr,
+                                &pool_name, &pool_name_len,
+                                NIL_P(dbname) ? NULL : RSTRING_ORATEXT(dbname),
+                                NIL_P(dbname) ? 0 : RSTRING_LEN(dbname),
+                                FIX2UINT(sess_min), FIX2UINT(sess_max),
+                                FIX2UINT(sess_incr),
+                                NIL_P(username) ? NULL : RSTRING_ORATEXT(username),
+                                NIL_P(username) ? 0 : RSTRING_LEN(username),
+                                NIL_P(password) ? NULL : RSTRING_ORATEXT(password),
+                                NIL_P(password) ? 0 : RSTRING_LEN(password),
+                                mode),
+           &spool->base);
+    RB_OBJ_WRITE(spool->base.self, &spool->pool_name, rb_str_new(TO_CHARPTR(pool_name), pool_name_len));
+    rb_str_freeze(spool->pool_name);
+    return Qnil;
+}
+
+/*
+ * call-seq:
+ *   reinitialize(min, max, incr)
+ *
+ * Changes the the number of minimum sessions, the number of
+ * maximum sessions and the session increment parameter.
+ *
+ * @since 2.2.15
+ */
+static VALUE oci8_spool_reinitialize(VALUE self, VALUE sess_min, VALUE sess_max, VALUE sess_incr)
+{
+    oci8_spool_t *spool = TO_SPOOL(self);
+    OraText *pool_name;
+    ub4 pool_name_len;
+
+    /* check arguments */
+    Check_Type(sess_min, T_FIXNUM);
+    Check_Type(sess_max, T_FIXNUM);
+    Check_Type(sess_incr, T_FIXNUM);
+
+    chker2(OCISessionPoolCreate(oci8_envhp, oci8_errhp, spool->base.hp.ptr,
+                                &pool_name, &pool_name_len, NULL, 0,
+                                FIX2UINT(sess_min), FIX2UINT(sess_max),
+                                FIX2UINT(sess_incr),
+                                NULL, 0, NULL, 0, OCI_SPC_REINITIALIZE),
+           &spool->base);
+    return self;
+}
+
+typedef struct {
+    OCIEnv *envhp;
+    OCIError *errhp;
+    OraText *pool_name;
+    ub4 pool_name_len;
+    OCISvcCtx *svchp;
+    sword rv;
+    volatile int *canceled;
+} warm_up_session_t;
+
+typedef struct {
+    warm_up_session_t *sessions;
+    int num;
+    int errnum;
+    volatile int canceled;
+} warm_up_arg_t;
+
+/* This runs in a native thread. */
+static void *warm_up_get_session(void *arg)
+{
+    warm_up_session_t *sess = (warm_up_session_t *)arg;
+
+    if (*sess->canceled) {
+        /* interrupted before this task starts. */
+        return NULL;
+    }
+    sess->rv = OCISessionGet(sess->envhp, sess->errhp, &sess->svchp, NULL,
+                             sess->pool_name, sess->pool_name_len,
+                             NULL, 0, NULL, NULL, NULL, OCI_SESSGET_SPOOL);
+    return NULL;
+}
+
+/* This runs without the GVL. */
+static void *warm_up_sessions(void *arg)
+{
+    warm_up_arg_t *wa = (warm_up_arg_t *)arg;
+    int i;
+
+    /* Get sessions at a time to make the pool create them concurrently. */
+    wa->errnum = oci8_run_native_threads_and_wait(warm_up_get_session, wa->sessions,
+                                                  sizeof(warm_up_session_t), wa->num);
+    /* Return them to the pool. */
+    for (i = 0; i < wa->num; i++) {
+        warm_up_session_t *sess = &wa->sessions[i];
+        if (sess->svchp != NULL && (sess->rv == OCI_SUCCESS || sess->rv == OCI_SUCCESS_WITH_INFO)) {
+            OCISessionRelease(sess->svchp, sess->errhp, NULL, 0, OCI_DEFAULT);
+        }
+    }
+    return NULL;
+}
+
+/*
+ * The unblock function of warm_up_sessions().
+ * Logins in progress cannot be interrupted. This stops tasks
+ * which haven't started yet. They run one by one when native
+ * threads cannot be created.
+ */
+static void warm_up_unblock(void *arg)
+{
+    warm_up_arg_t *wa = (warm_up_arg_t *)arg;
+
+    wa->canceled = 1;
+}
+
+static VALUE warm_up_ensure(VALUE arg)
+{
+    warm_up_arg_t *wa = (warm_up_arg_t *)arg;
+    int i;
+
+    for (i = 0; i < wa->num; i++) {
+        if (wa->sessions[i].errhp != NULL) {
+            OCIHandleFree(wa->sessions[i].errhp, OCI_HTYPE_ERROR);
+        }
+    }
+    xfree(wa->sessions);
+    return Qnil;
+}
+
+static VALUE warm_up_body(VALUE arg)
+{
+    warm_up_arg_t *wa = (warm_up_arg_t *)arg;
+    int i;
+
+#ifdef HAVE_RB_THREAD_CALL_WITHOUT_GVL
+    rb_thread_call_without_gvl(warm_up_sessions, wa, warm_up_unblock, wa);
+#else
+    rb_thread_blocking_region((VALUE(*)(void*))warm_up_sessions, wa, warm_up_unblock, wa);
+#endif
+    /* raise an exception such as Interrupt if the call is canceled. */
+    rb_thread_check_ints();
+    if (wa->errnum != 0) {
+        errno = wa->errnum;
+        rb_sys_fail("oci8_run_native_threads_and_wait");
+    }
+    for (i = 0; i < wa->num; i++) {
+        warm_up_session_t *sess = &wa->sessions[i];
+        if (sess->rv != OCI_SUCCESS && sess->rv != OCI_SUCCESS_WITH_INFO) {
+            oci8_raise(sess->errhp, sess->rv, NULL);
+        }
+    }
+    return Qnil;
+}
+
+/*
+ * call-seq:
+ *   warm_up(num_sessions)
+ *
+ * Makes the pool open at least <i>num_sessions</i> sessions.
+ *
+ * Sessions are got from the pool in native threads at a time and
+ * returned to the pool. So the pool creates them concurrently and
+ * it takes about the time of one login instead of
+ * <i>num_sessions</i> times. This returns after all sessions are
+ * ready. When some of them fail, the first error is raised after
+ * successful ones return to the pool.
+ *
+ * Note that logins in progress cannot be interrupted. When the
+ * thread is interrupted, for example by Ctrl-C, logins not started
+ * yet are skipped and the interrupt is raised after logins in
+ * progress finish.
+ *
+ * This is available only for homogeneous pools, which are created
+ * with username and password. <i>num_sessions</i> is limited to
+ * the maximum number of sessions minus the number of sessions in
+ * use so that it doesn't wait for busy sessions returned to the
+ * pool.
+ *
+ * @example
+ *   spool = OCI8::SessionPool.new(0, 50, 5, username, password, database)
+ *   spool.warm_up(50)
+ *
+ * @param [Integer] num_sessions
+ * @return [Integer] the number of open sessions
+ * @since 2.2.15
+ */
+static VALUE oci8_spool_warm_up(VALUE self, VALUE num_sessions)
+{
+    oci8_spool_t *spool = TO_SPOOL(self);
+    warm_up_arg_t wa;
+    ub4 max = 0;
+    ub4 busy = 0;
+    int num = NUM2INT(num_sessions);
+    int i;
+    sword rv;
+
+    if (!spool->homogeneous) {
+        rb_raise(rb_eRuntimeError, "warm_up is available only for homogeneous session pools.");
+    }
+    if (!have_OCISessionGet) {
+        rb_raise(rb_eRuntimeError, "undefined OCI function %s is called", "OCISessionGet");
+    }
+    chker2(OCIAttrGet(spool->base.hp.ptr, OCI_HTYPE_SPOOL, &max, 0, OCI_ATTR_SPOOL_MAX, oci8_errhp),
+           &spool->base);
+    chker2(OCIAttrGet(spool->base.hp.ptr, OCI_HTYPE_SPOOL, &busy, 0, OCI_ATTR_SPOOL_BUSY_COUNT, oci8_errhp),
+           &spool->base);
+    if (busy > max) {
+        busy = max;
+    }
+    if (num > (int)(max - busy)) {
+        num = (int)(max - busy);
+    }
+    if (num > 0) {
+        wa.sessions = ALLOC_N(warm_up_session_t, num);
+        memset(wa.sessions, 0, sizeof(warm_up_session_t) * num);
+        wa.num = num;
+        wa.errnum = 0;
+        wa.canceled = 0;
+        for (i = 0; i < num; i++) {
+            warm_up_session_t *sess = &wa.sessions[i];
+            sess->canceled = &wa.canceled;
+            sess->envhp = oci8_envhp;
+            sess->pool_name = RSTRING_ORATEXT(spool->pool_name);
+            sess->pool_name_len = RSTRING_LEN(spool->pool_name);
+            rv = OCIHandleAlloc(oci8_envhp, (dvoid *)&sess->errhp, OCI_HTYPE_ERROR, 0, NULL);
+            if (rv != OCI_SUCCESS) {
+                warm_up_ensure((VALUE)&wa);
+                oci8_env_raise(oci8_envhp, rv);
+            }
+        }
+        rb_ensure(warm_up_body, (VALUE)&wa, warm_up_ensure, (VALUE)&wa);
+    }
+    return rb_funcall(self, rb_intern("open_count"), 0);
+}
+
+/*
+ * call-seq:
+ *   pool_name -> string
+ *
+ * Retruns the pool name.
+ *
+ * @private
+ */
+static VALUE oci8_spool_pool_name(VALUE self)
+{
+    oci8_spool_t *spool = TO_SPOOL(self);
+
+    return spool->pool_name;
+}
+
+void Init_oci8_session_pool(VALUE cOCI8)
+{
+#if 0
+    cOCIHandle = rb_define_class("OCIHandle", rb_cObject);
+    cOCI8 = rb_define_class("OCI8", cOCIHandle);
+    cOCISessionPool = rb_define_class_under(cOCI8, "SessionPool", cOCIHandle);
+#endif
+
+    cOCISessionPool = oci8_define_class_under(cOCI8, "SessionPool", &oci8_spool_data_type, oci8_spool_alloc);
+
+    rb_define_private_method(cOCISessionPool, "initialize", oci8_spool_initialize, -1);
+    rb_define_method(cOCISessionPool, "reinitialize", oci8_spool_reinitialize, 3);
+    rb_define_method(cOCISessionPool, "warm_up", oci8_spool_warm_up, 1);
+    rb_define_private_method(cOCISessionPool, "pool_name", oci8_spool_pool_name, 0);
+}
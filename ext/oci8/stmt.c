@@ -8,7 +8,13 @@
  */
 #include "oci8.h"
 
+#ifndef OCI_ATTR_PREFETCH_MEMORY
+#define OCI_ATTR_PREFETCH_MEMORY 13
+#endif
+
 static VALUE cOCIStmt;
+static ID id_at_define_handles;
+static ID id_get_packed_data;
 
 #define TO_STMT(obj) ((oci8_stmt_t *)oci8_check_typeddata((obj), &oci8_stmt_data_type, 1))
 
@@ -17,12 +23,37 @@ typedef struct {
     VALUE svc;
     char use_stmt_release;
     char end_of_fetch;
+    char no_prefetch;
+    ub4 prefetch_rows;
+    ub4 prefetch_memory;
+    ub4 prefetched_rows; /* number of rows surely in the pre-fetch buffer */
+    VALUE batch_errors; /* errors collected by the last execution in OCI_BATCH_ERRORS mode */
 } oci8_stmt_t;
 
+/*
+ * Copies the statement handle and its state from src to dst, which
+ * is newly allocated. Fields added to oci8_stmt_t must be copied
+ * here. batch_errors isn't copied because it belongs to the last
+ * execution.
+ */
+static void oci8_stmt_copy_state(oci8_stmt_t *dst, const oci8_stmt_t *src)
+{
+    dst->base.type = src->base.type;
+    dst->base.hp.ptr = src->base.hp.ptr;
+    RB_OBJ_WRITE(dst->base.self, &dst->svc, src->svc);
+    dst->use_stmt_release = src->use_stmt_release;
+    dst->end_of_fetch = src->end_of_fetch;
+    dst->no_prefetch = src->no_prefetch;
+    dst->prefetch_rows = src->prefetch_rows;
+    dst->prefetch_memory = src->prefetch_memory;
+    dst->prefetched_rows = src->prefetched_rows;
+}
+
 static void oci8_stmt_mark(oci8_base_t *base)
 {
     oci8_stmt_t *stmt = (oci8_stmt_t *)base;
     rb_gc_mark(stmt->svc);
+    rb_gc_mark(stmt->batch_errors);
 }
 
 static void oci8_stmt_free(oci8_base_t *base)
@@ -56,7 +87,11 @@ static const oci8_handle_data_type_t oci8_stmt_data_type = {
 
 static VALUE oci8_stmt_alloc(VALUE klass)
 {
-    return oci8_allocate_typeddata(klass, &oci8_stmt_data_type);
+    VALUE self = oci8_allocate_typeddata(klass, &oci8_stmt_data_type);
+    oci8_stmt_t *stmt = (oci8_stmt_t *)RTYPEDDATA_DATA(self);
+
+    stmt->batch_errors = Qnil;
+    return self;
 }
 
 /*
@@ -97,6 +132,44 @@ static VALUE oci8_stmt_initialize(VALUE self, VALUE svc, VALUE sql)
     return Qnil;
 }
 
+/*
+ * @overload __detach
+ *
+ *  Moves the statement handle and define and bind handles to a new
+ *  cursor and closes +self+. This returns +nil+ when +self+ is
+ *  already closed.
+ *
+ *  @return [OCI8::Cursor or nil]
+ *
+ *  @private
+ */
+static VALUE oci8_stmt_detach(VALUE self)
+{
+    oci8_stmt_t *stmt = (oci8_stmt_t *)oci8_check_typeddata(self, &oci8_stmt_data_type, 0);
+    oci8_stmt_t *newstmt;
+    VALUE obj;
+
+    if (stmt->base.closed) {
+        return Qnil;
+    }
+    obj = oci8_stmt_alloc(CLASS_OF(self));
+    newstmt = (oci8_stmt_t *)RTYPEDDATA_DATA(obj);
+    oci8_stmt_copy_state(newstmt, stmt);
+    while (stmt->base.children != NULL) {
+        oci8_link_to_parent(stmt->base.children, &newstmt->base);
+    }
+    if (stmt->base.parent != NULL) {
+        oci8_link_to_parent(&newstmt->base, stmt->base.parent);
+        oci8_unlink_from_parent(&stmt->base);
+    }
+    stmt->base.type = 0;
+    stmt->base.closed = 1;
+    stmt->base.hp.ptr = NULL;
+    stmt->use_stmt_release = 0;
+    RB_OBJ_WRITE(self, &stmt->batch_errors, Qnil);
+    return obj;
+}
+
 /*
  * @overload __define(position, bindobj)
  *
@@ -249,25 +322,128 @@ static sword oci8_call_stmt_execute(oci8_svcctx_t *svcctx, oci8_stmt_t *stmt, ub
     return rv;
 }
 
+typedef struct {
+    oci8_stmt_t *stmt;
+    OCIError *errhndl;
+} batch_errors_arg_t;
+
 /*
- * @overload __execute(iteration_count)
+ * Collects errors of rows which failed in OCI_BATCH_ERRORS mode.
+ * This must be called just after OCIStmtExecute because they are
+ * got from oci8_errhp, which is shared by all OCI calls in the thread.
+ */
+static VALUE get_batch_errors(VALUE varg)
+{
+    batch_errors_arg_t *arg = (batch_errors_arg_t *)varg;
+    oci8_stmt_t *stmt = arg->stmt;
+    OCIError *errhp = oci8_errhp;
+    ub4 num_errs = 0;
+    VALUE ary;
+    ub4 i;
+    sword rv;
+
+    chker2(OCIAttrGet(stmt->base.hp.stmt, OCI_HTYPE_STMT, &num_errs, 0, OCI_ATTR_NUM_DML_ERRORS, errhp),
+           &stmt->base);
+    ary = rb_ary_new2(num_errs);
+    if (num_errs == 0) {
+        return ary;
+    }
+    rv = OCIHandleAlloc(oci8_envhp, (dvoid *)&arg->errhndl, OCI_HTYPE_ERROR, 0, NULL);
+    if (rv != OCI_SUCCESS) {
+        oci8_env_raise(oci8_envhp, rv);
+    }
+    for (i = 0; i < num_errs; i++) {
+        ub4 row_offset = 0;
+
+        chker2(OCIParamGet(errhp, OCI_HTYPE_ERROR, errhp, (dvoid *)&arg->errhndl, i),
+               &stmt->base);
+        chker2(OCIAttrGet(arg->errhndl, OCI_HTYPE_ERROR, &row_offset, 0, OCI_ATTR_DML_ROW_OFFSET, errhp),
+               &stmt->base);
+        rb_ary_push(ary, rb_assoc_new(UINT2NUM(row_offset),
+                                      oci8_make_ocierror(arg->errhndl, NULL)));
+    }
+    return ary;
+}
+
+static VALUE batch_errors_ensure(VALUE varg)
+{
+    batch_errors_arg_t *arg = (batch_errors_arg_t *)varg;
+    if (arg->errhndl != NULL) {
+        OCIHandleFree(arg->errhndl, OCI_HTYPE_ERROR);
+    }
+    return Qnil;
+}
+
+/*
+ * @overload __execute(iteration_count, batch_errors = false)
  *
  *  @param [Integer] iteration_count
+ *  @param [Boolean] batch_errors  true to execute in OCI_BATCH_ERRORS mode
  *
  *  @private
  */
-static VALUE oci8_stmt_execute(VALUE self, VALUE iteration_count)
+static VALUE oci8_stmt_execute(int argc, VALUE *argv, VALUE self)
 {
     oci8_stmt_t *stmt = TO_STMT(self);
     oci8_svcctx_t *svcctx = oci8_get_svcctx(stmt->svc);
+    VALUE iteration_count, batch_errors;
+    ub4 mode;
 
+    rb_scan_args(argc, argv, "11", &iteration_count, &batch_errors);
+    mode = svcctx->is_autocommit ? OCI_COMMIT_ON_SUCCESS : OCI_DEFAULT;
+    if (RTEST(batch_errors)) {
+        mode |= OCI_BATCH_ERRORS;
+    }
     stmt->end_of_fetch = 0;
-    chker3(oci8_call_stmt_execute(svcctx, stmt, NUM2UINT(iteration_count),
-                                  svcctx->is_autocommit ? OCI_COMMIT_ON_SUCCESS : OCI_DEFAULT),
+    stmt->prefetched_rows = 0;
+    RB_OBJ_WRITE(stmt->base.self, &stmt->batch_errors, Qnil);
+    chker3(oci8_call_stmt_execute(svcctx, stmt, NUM2UINT(iteration_count), mode),
            &stmt->base, stmt->base.hp.stmt);
+    if (mode & OCI_BATCH_ERRORS) {
+        batch_errors_arg_t arg;
+
+        arg.stmt = stmt;
+        arg.errhndl = NULL;
+        RB_OBJ_WRITE(stmt->base.self, &stmt->batch_errors,
+                     rb_ensure(get_batch_errors, (VALUE)&arg, batch_errors_ensure, (VALUE)&arg));
+    }
+    if (OCIAttrGet(stmt->base.hp.stmt, OCI_HTYPE_STMT, &stmt->prefetch_rows, 0, OCI_ATTR_PREFETCH_ROWS, oci8_errhp) != OCI_SUCCESS) {
+        stmt->prefetch_rows = 0;
+    }
+    if (OCIAttrGet(stmt->base.hp.stmt, OCI_HTYPE_STMT, &stmt->prefetch_memory, 0, OCI_ATTR_PREFETCH_MEMORY, oci8_errhp) != OCI_SUCCESS) {
+        stmt->prefetch_memory = UB4MAXVAL;
+    }
     return self;
 }
 
+/*
+ * @overload batch_errors
+ *
+ *  Returns errors of rows which failed in the last execution by
+ *  {#exec_array} with +batch_errors+ true. Each element is a pair of
+ *  the offset of the failed row, which starts from zero, and an
+ *  OCIError object.
+ *
+ *  @example
+ *    cursor.exec_array(true)
+ *    cursor.batch_errors.each do |offset, err|
+ *      puts "row #{offset}: #{err.message}"
+ *    end
+ *
+ *  @return [Array]
+ *
+ *  @since 2.2.15
+ */
+static VALUE oci8_stmt_get_batch_errors(VALUE self)
+{
+    oci8_stmt_t *stmt = TO_STMT(self);
+
+    if (NIL_P(stmt->batch_errors)) {
+        return rb_ary_new();
+    }
+    return rb_ary_dup(stmt->batch_errors);
+}
+
 /*
  * @overload __fetch(connection, max_rows)
  *
@@ -287,6 +463,7 @@ static VALUE oci8_stmt_fetch(VALUE self, VALUE svc, VALUE max_rows)
     oci8_bind_t *obind;
     const oci8_bind_data_type_t *data_type;
     ub4 nrows = NUM2UINT(max_rows);
+    char no_prefetch = 0;
 
     if (stmt->end_of_fetch) {
         return Qnil;
@@ -303,21 +480,228 @@ static VALUE oci8_stmt_fetch(VALUE self, VALUE svc, VALUE max_rows)
                 if (nrows > 1 && nrows != obind->maxar_sz) {
                     rb_raise(rb_eRuntimeError, "fetch size (%u) != define-handle size %u", nrows, obind->maxar_sz);
                 }
+                switch (data_type->dty) {
+                case SQLT_CHR: /* LONG */
+                case SQLT_BIN: /* LONG RAW */
+                case SQLT_CLOB:
+                case SQLT_BLOB:
+                case SQLT_BFILE:
+                case SQLT_NTY:
+                case SQLT_RSET:
+                    /* Rows aren't prefetched when the select list
+                     * contains these types.
+                     */
+                    no_prefetch = 1;
+                    break;
+                }
             }
             obind = (oci8_bind_t *)obind->base.next;
         } while (obind != (oci8_bind_t*)stmt->base.children);
     }
-    rv = OCIStmtFetch_nb(svcctx, stmt->base.hp.stmt, oci8_errhp, nrows, OCI_FETCH_NEXT, OCI_DEFAULT);
-    if (rv == OCI_NO_DATA) {
-        stmt->end_of_fetch = 1;
+    /* Fetch rows without releasing the GVL to avoid overhead of
+     * switching threads only when they are surely in the pre-fetch
+     * buffer. The condition must not be a guess because a round trip
+     * in this call blocks all threads and fibers and cannot be
+     * interrupted by OCI8#break.
+     */
+    if (svcctx->non_blocking && !svcctx->async_mode && !no_prefetch
+        && nrows <= stmt->prefetched_rows && NIL_P(svcctx->executing_thread)) {
+        rv = OCIStmtFetch(stmt->base.hp.stmt, oci8_errhp, nrows, OCI_FETCH_NEXT, OCI_DEFAULT);
+        stmt->prefetched_rows -= nrows;
+        if (rv == OCI_NO_DATA) {
+            stmt->end_of_fetch = 1;
+        } else {
+            chker3(rv, &svcctx->base, stmt->base.hp.stmt);
+        }
+        chker2(OCIAttrGet(stmt->base.hp.stmt, OCI_HTYPE_STMT, &nrows, 0, OCI_ATTR_ROWS_FETCHED, oci8_errhp),
+               &svcctx->base);
     } else {
-        chker3(rv, &svcctx->base, stmt->base.hp.stmt);
+        ub4 max_rows = nrows;
+
+        rv = OCIStmtFetch_nb(svcctx, stmt->base.hp.stmt, oci8_errhp, nrows, OCI_FETCH_NEXT, OCI_DEFAULT);
+        if (rv == OCI_NO_DATA) {
+            stmt->end_of_fetch = 1;
+        } else {
+            chker3(rv, &svcctx->base, stmt->base.hp.stmt);
+        }
+        chker2(OCIAttrGet(stmt->base.hp.stmt, OCI_HTYPE_STMT, &nrows, 0, OCI_ATTR_ROWS_FETCHED, oci8_errhp),
+               &svcctx->base);
+        /* A round trip fills the pre-fetch buffer with prefetch_rows
+         * rows unless the pre-fetch memory is limited. Rows left in the
+         * buffer before the fetch are ignored to underestimate the
+         * number. When fewer rows than requested are returned, the
+         * server may not have sent more rows.
+         */
+        if (!no_prefetch && stmt->prefetch_memory == 0 && rv == OCI_SUCCESS
+            && nrows == max_rows && stmt->prefetch_rows > max_rows) {
+            stmt->prefetched_rows = stmt->prefetch_rows - max_rows;
+        } else {
+            stmt->prefetched_rows = 0;
+        }
     }
-    chker2(OCIAttrGet(stmt->base.hp.stmt, OCI_HTYPE_STMT, &nrows, 0, OCI_ATTR_ROWS_FETCHED, oci8_errhp),
-           &svcctx->base);
     return nrows ? UINT2NUM(nrows) : Qnil;
 }
 
+/*
+ * @overload __fetch_row_as_array(index)
+ *
+ *  Returns the <i>index</i>-th row in the fetched rows as an array.
+ *  The values are retrieved directly from the define handles in
+ *  the column order of @define_handles without calling
+ *  OCI8::BindType::Base#get_data for each column.
+ *
+ *  This is called by private methods of OCI8::Cursor.
+ *
+ *  @param [Integer] index  row index in the fetched rows which starts from zero
+ *  @return [Array]
+ *
+ *  @private
+ */
+static VALUE oci8_stmt_fetch_row_as_array(VALUE self, VALUE index)
+{
+    VALUE handles = rb_ivar_get(self, id_at_define_handles);
+    ub4 idx = NUM2UINT(index);
+    volatile VALUE ary;
+    long i;
+
+    Check_Type(handles, T_ARRAY);
+    ary = rb_ary_new2(RARRAY_LEN(handles));
+    for (i = 0; i < RARRAY_LEN(handles); i++) {
+        oci8_bind_t *obind = TO_BIND(RARRAY_AREF(handles, i));
+
+        if (idx >= obind->maxar_sz) {
+            rb_raise(rb_eRuntimeError, "data index is too big. (%u for %u)", idx, obind->maxar_sz);
+        }
+        rb_ary_store(ary, i, oci8_bind_get_at(obind, idx));
+    }
+    return ary;
+}
+
+/*
+ * @overload __fetch_columns(index, num_rows, columns = nil, packed_types = nil)
+ *
+ *  Returns <i>num_rows</i> rows from the <i>index</i>-th row in
+ *  the fetched rows as an array of columns. Each column is an array
+ *  whose size is <i>num_rows</i>.
+ *
+ *  When <i>columns</i> is passed, the values are appended to it.
+ *
+ *  When the i-th element of <i>packed_types</i> is +:int64+ or +:double+,
+ *  the i-th column is a pair of packed values and a null bitmap made
+ *  by OCI8::BindType::OraNumber#get_packed_data.
+ *
+ *  This is called by private methods of OCI8::Cursor.
+ *
+ *  @param [Integer] index     row index in the fetched rows which starts from zero
+ *  @param [Integer] num_rows  number of rows
+ *  @param [Array] columns     columns returned by the previous call
+ *  @param [Array] packed_types
+ *  @return [Array of Array]
+ *
+ *  @private
+ */
+static VALUE oci8_stmt_fetch_columns(int argc, VALUE *argv, VALUE self)
+{
+    VALUE handles = rb_ivar_get(self, id_at_define_handles);
+    VALUE index, num_rows, columns, packed_types;
+    ub4 idx;
+    ub4 nrows;
+    long i;
+
+    rb_scan_args(argc, argv, "22", &index, &num_rows, &columns, &packed_types);
+    idx = NUM2UINT(index);
+    nrows = NUM2UINT(num_rows);
+    Check_Type(handles, T_ARRAY);
+    if (NIL_P(columns)) {
+        columns = rb_ary_new2(RARRAY_LEN(handles));
+    } else {
+        Check_Type(columns, T_ARRAY);
+    }
+    if (!NIL_P(packed_types)) {
+        Check_Type(packed_types, T_ARRAY);
+    }
+    for (i = 0; i < RARRAY_LEN(handles); i++) {
+        VALUE handle = RARRAY_AREF(handles, i);
+        oci8_bind_t *obind = TO_BIND(handle);
+        VALUE type = NIL_P(packed_types) ? Qnil : rb_ary_entry(packed_types, i);
+        VALUE column = rb_ary_entry(columns, i);
+        ub4 j;
+
+        if (idx > obind->maxar_sz || nrows > obind->maxar_sz - idx) {
+            rb_raise(rb_eRuntimeError, "data index is too big. (%u + %u for %u)", idx, nrows, obind->maxar_sz);
+        }
+        if (!NIL_P(type)) {
+            VALUE args[5];
+
+            args[0] = type;
+            args[1] = index;
+            args[2] = num_rows;
+            args[3] = NIL_P(column) ? Qnil : rb_ary_entry(column, 0);
+            args[4] = NIL_P(column) ? Qnil : rb_ary_entry(column, 1);
+            rb_ary_store(columns, i, rb_funcall2(handle, id_get_packed_data, 5, args));
+            continue;
+        }
+        if (NIL_P(column)) {
+            column = rb_ary_new2(nrows);
+            rb_ary_store(columns, i, column);
+        }
+        for (j = 0; j < nrows; j++) {
+            rb_ary_push(column, oci8_bind_get_at(obind, idx + j));
+        }
+    }
+    return columns;
+}
+
+/*
+ * @overload __prefetch_rows=(rows)
+ *
+ *  Sets OCI_ATTR_PREFETCH_ROWS. The estimated number of rows in
+ *  the pre-fetch buffer is reset not to fetch rows with the GVL
+ *  held by the old value.
+ *
+ *  @param [Integer] rows
+ *
+ *  @private
+ */
+static VALUE oci8_stmt_set_prefetch_rows(VALUE self, VALUE rows)
+{
+    oci8_stmt_t *stmt = TO_STMT(self);
+    ub4 val = NUM2UINT(rows);
+
+    chker2(OCIAttrSet(stmt->base.hp.stmt, OCI_HTYPE_STMT, &val, 0, OCI_ATTR_PREFETCH_ROWS, oci8_errhp),
+           &stmt->base);
+    stmt->prefetch_rows = val;
+    stmt->prefetched_rows = 0;
+    return rows;
+}
+
+/*
+ * @overload __define_row_size
+ *
+ *  Returns the number of bytes of the define handles used per row.
+ *
+ *  This is called by private methods of OCI8::Cursor.
+ *
+ *  @return [Integer]
+ *
+ *  @private
+ */
+static VALUE oci8_stmt_define_row_size(VALUE self)
+{
+    VALUE handles = rb_ivar_get(self, id_at_define_handles);
+    long size = 0;
+    long i;
+
+    Check_Type(handles, T_ARRAY);
+    for (i = 0; i < RARRAY_LEN(handles); i++) {
+        oci8_bind_t *obind = TO_BIND(RARRAY_AREF(handles, i));
+
+        size += obind->alloc_sz;
+        size += NIL_P(obind->tdo) ? sizeof(sb2) : sizeof(void *);
+    }
+    return LONG2NUM(size);
+}
+
 /*
  * @overload __paramGet(pos)
  *
@@ -342,6 +726,58 @@ static VALUE oci8_stmt_get_param(VALUE self, VALUE pos)
     return oci8_metadata_create(parmhp, stmt->svc, self);
 }
 
+/* compact description of a select-list column used by __column_descs */
+typedef struct {
+    ub2 data_type;
+    ub2 data_size;
+    ub2 char_size;
+    sb2 precision;
+    sb1 scale;
+    ub1 charset_form;
+} column_desc_t;
+
+/*
+ * @overload __column_descs(num_cols)
+ *
+ *  Returns a binary string which concatenates the data type, size,
+ *  precision, scale and character set form of each select-list
+ *  column. It is compared with the string got by the first
+ *  execution of the same statement shape to skip creating
+ *  OCI8::Metadata objects.
+ *
+ *  @param [Integer] num_cols the number of select-list columns
+ *  @return [String]
+ *
+ *  @private
+ */
+static VALUE oci8_stmt_column_descs(VALUE self, VALUE num_cols)
+{
+    oci8_stmt_t *stmt = TO_STMT(self);
+    ub4 num = NUM2UINT(num_cols);
+    VALUE str = rb_str_buf_new(num * sizeof(column_desc_t));
+    ub4 pos;
+
+    for (pos = 1; pos <= num; pos++) {
+        OCIParam *parmhp = NULL;
+        column_desc_t desc;
+        sword rv;
+
+        rv = OCIParamGet(stmt->base.hp.stmt, OCI_HTYPE_STMT, oci8_errhp, (dvoid *)&parmhp, pos);
+        if (rv != OCI_SUCCESS) {
+            chker3(rv, &stmt->base, stmt->base.hp.stmt);
+        }
+        memset(&desc, 0, sizeof(desc));
+        chker2(OCIAttrGet(parmhp, OCI_DTYPE_PARAM, &desc.data_type, 0, OCI_ATTR_DATA_TYPE, oci8_errhp), &stmt->base);
+        chker2(OCIAttrGet(parmhp, OCI_DTYPE_PARAM, &desc.data_size, 0, OCI_ATTR_DATA_SIZE, oci8_errhp), &stmt->base);
+        chker2(OCIAttrGet(parmhp, OCI_DTYPE_PARAM, &desc.char_size, 0, OCI_ATTR_CHAR_SIZE, oci8_errhp), &stmt->base);
+        chker2(OCIAttrGet(parmhp, OCI_DTYPE_PARAM, &desc.precision, 0, OCI_ATTR_PRECISION, oci8_errhp), &stmt->base);
+        chker2(OCIAttrGet(parmhp, OCI_DTYPE_PARAM, &desc.scale, 0, OCI_ATTR_SCALE, oci8_errhp), &stmt->base);
+        chker2(OCIAttrGet(parmhp, OCI_DTYPE_PARAM, &desc.charset_form, 0, OCI_ATTR_CHARSET_FORM, oci8_errhp), &stmt->base);
+        rb_str_buf_cat(str, (const char *)&desc, sizeof(desc));
+    }
+    return str;
+}
+
 /*
  *  Gets the rowid of the last inserted, updated or deleted row.
  *  This cannot be used for select statements.
@@ -435,14 +871,23 @@ void Init_oci8_stmt(VALUE cOCI8)
     cOCIStmt = rb_define_class_under(cOCI8, "Cursor", cOCIHandle);
 #endif
     cOCIStmt = oci8_define_class_under(cOCI8, "Cursor", &oci8_stmt_data_type, oci8_stmt_alloc);
+    id_at_define_handles = rb_intern("@define_handles");
+    id_get_packed_data = rb_intern("get_packed_data");
 
     rb_define_private_method(cOCIStmt, "__initialize", oci8_stmt_initialize, 2);
+    rb_define_private_method(cOCIStmt, "__detach", oci8_stmt_detach, 0);
     rb_define_private_method(cOCIStmt, "__define", oci8_define_by_pos, 2);
     rb_define_private_method(cOCIStmt, "__bind", oci8_bind, 2);
-    rb_define_private_method(cOCIStmt, "__execute", oci8_stmt_execute, 1);
+    rb_define_private_method(cOCIStmt, "__execute", oci8_stmt_execute, -1);
     rb_define_private_method(cOCIStmt, "__fetch", oci8_stmt_fetch, 2);
+    rb_define_private_method(cOCIStmt, "__fetch_row_as_array", oci8_stmt_fetch_row_as_array, 1);
+    rb_define_private_method(cOCIStmt, "__fetch_columns", oci8_stmt_fetch_columns, -1);
+    rb_define_private_method(cOCIStmt, "__define_row_size", oci8_stmt_define_row_size, 0);
+    rb_define_private_method(cOCIStmt, "__prefetch_rows=", oci8_stmt_set_prefetch_rows, 1);
     rb_define_private_method(cOCIStmt, "__paramGet", oci8_stmt_get_param, 1);
+    rb_define_private_method(cOCIStmt, "__column_descs", oci8_stmt_column_descs, 1);
     rb_define_method(cOCIStmt, "rowid", oci8_stmt_get_rowid, 0);
+    rb_define_method(cOCIStmt, "batch_errors", oci8_stmt_get_batch_errors, 0);
 
     oci8_define_bind_class("Cursor", &bind_stmt_data_type, bind_stmt_alloc);
 }
@@ -7,7 +7,9 @@
 #include "oci8.h"
 #include <errno.h>
 
-#ifndef WIN32
+#ifdef WIN32
+#include <windows.h>
+#else
 #include <pthread.h>
 static pthread_attr_t detached_thread_attr;
 #endif
@@ -17,6 +19,24 @@ typedef struct {
     void *arg;
 } adapter_arg_t;
 
+/* A countdown latch used by oci8_run_native_threads_and_wait(). */
+typedef struct {
+#ifdef WIN32
+    LONG count;
+    HANDLE event;
+#else
+    int count;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+#endif
+} latch_t;
+
+typedef struct {
+    void *(*func)(void *);
+    void *arg;
+    latch_t *latch;
+} task_t;
+
 void Init_oci8_thread_util(void)
 {
 #ifndef WIN32
@@ -79,3 +99,72 @@ int oci8_run_native_thread(void *(*func)(void *), void *arg)
     return rv;
 }
 #endif /* WIN32 */
+
+static void *run_task(void *arg)
+{
+    task_t *task = (task_t *)arg;
+    latch_t *latch = task->latch;
+
+    task->func(task->arg);
+#ifdef WIN32
+    if (InterlockedDecrement(&latch->count) == 0) {
+        SetEvent(latch->event);
+    }
+#else
+    pthread_mutex_lock(&latch->mutex);
+    if (--latch->count == 0) {
+        pthread_cond_signal(&latch->cond);
+    }
+    pthread_mutex_unlock(&latch->mutex);
+#endif
+    return NULL;
+}
+
+int oci8_run_native_threads_and_wait(void *(*func)(void *), void *args, size_t size, int num)
+{
+    task_t *tasks;
+    latch_t latch;
+    int i;
+
+    if (num <= 0) {
+        return 0;
+    }
+    tasks = malloc(sizeof(task_t) * num);
+    if (tasks == NULL) {
+        return ENOMEM;
+    }
+    latch.count = num;
+#ifdef WIN32
+    latch.event = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (latch.event == NULL) {
+        free(tasks);
+        return ENOMEM;
+    }
+#else
+    pthread_mutex_init(&latch.mutex, NULL);
+    pthread_cond_init(&latch.cond, NULL);
+#endif
+    for (i = 0; i < num; i++) {
+        tasks[i].func = func;
+        tasks[i].arg = (char *)args + size * i;
+        tasks[i].latch = &latch;
+        if (oci8_run_native_thread(run_task, &tasks[i]) != 0) {
+            /* run it in this thread when a thread cannot be created. */
+            run_task(&tasks[i]);
+        }
+    }
+#ifdef WIN32
+    WaitForSingleObject(latch.event, INFINITE);
+    CloseHandle(latch.event);
+#else
+    pthread_mutex_lock(&latch.mutex);
+    while (latch.count > 0) {
+        pthread_cond_wait(&latch.cond, &latch.mutex);
+    }
+    pthread_mutex_unlock(&latch.mutex);
+    pthread_cond_destroy(&latch.cond);
+    pthread_mutex_destroy(&latch.mutex);
+#endif
+    free(tasks);
+    return 0;
+}
@@ -16,3 +16,12 @@ void Init_oci8_thread_util(void);
  * The return value is errno.
  */
 int oci8_run_native_thread(void *(*func)(void *), void *arg);
+
+/*
+ * Run the func in num native threads and wait until all of them finish.
+ * The func is called with (char*)args + size * i, where i is 0 to num - 1.
+ * Don't call any ruby functions in the func and call this without
+ * the GVL.
+ * The return value is errno.
+ */
+int oci8_run_native_threads_and_wait(void *(*func)(void *), void *args, size_t size, int num);
@@ -185,8 +185,11 @@ require 'oci8/datetime.rb'
 require 'oci8/oci8.rb'
 require 'oci8/cursor.rb'
 require 'oci8/bindtype.rb'
+require 'oci8/lob.rb'
 require 'oci8/metadata.rb'
 require 'oci8/compat.rb'
 require 'oci8/object.rb'
 require 'oci8/connection_pool.rb'
+require 'oci8/session_pool.rb'
+require 'oci8/pool.rb'
 require 'oci8/properties.rb'
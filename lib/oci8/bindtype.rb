@@ -7,12 +7,97 @@
 #
 class OCI8
   module BindType
-    Mapping = {}
+    # A hash which counts its changes. Define plans cached by
+    # {DefinePlanCache} are invalidated by the count.
+    #
+    # @private
+    class MappingHash < ::Hash
+      # Returns the number of changes.
+      def version
+        @version || 0
+      end
+
+      [:[]=, :store, :delete, :delete_if, :reject!, :select!, :keep_if, :filter!,
+       :merge!, :update, :replace, :clear, :shift, :default=, :default_proc=,
+       :compare_by_identity].each do |name|
+        next unless method_defined?(name)
+        define_method(name) do |*args, &block|
+          @version = version + 1
+          super(*args, &block)
+        end
+      end
+    end
+
+    Mapping = MappingHash.new
+
+    # Define plans cached per shape of select-list columns.
+    #
+    # Plans are looked up by the shape with the version of {Mapping},
+    # OCI8.nls_ratio and OCI8.encoding, which define plans depend on.
+    # The least recently used plan is removed when the cache is full.
+    #
+    # @private
+    class DefinePlanCache
+      # The maximum number of cached plans.
+      MAX_SIZE = 256
+
+      def initialize
+        @plans = {}
+      end
+
+      def [](descs)
+        key = cache_key(descs)
+        plan = @plans.delete(key)
+        @plans[key] = plan if plan # move to the most recently used position.
+        plan
+      end
+
+      def []=(descs, plan)
+        key = cache_key(descs)
+        @plans.delete(key)
+        @plans.shift if @plans.size >= MAX_SIZE
+        @plans[key] = plan
+      end
+
+      def size
+        @plans.size
+      end
+
+      def clear
+        @plans.clear
+      end
+
+      private
+
+      def cache_key(descs)
+        [descs, Mapping.version, OCI8.nls_ratio, OCI8.encoding]
+      end
+    end
+
+    # @private
+    DefinePlans = DefinePlanCache.new
 
     class Base
       def self.create(con, val, param, max_array_size)
         self.new(con, val, param, max_array_size)
       end
+
+      # Returns the bind class and the parameter passed to its
+      # constructor to define a column described by +param+.
+      # The result is cached per shape of select-list columns.
+      # So it must not refer the metadata object itself.
+      #
+      # @private
+      def self.define_plan(param)
+        [self, nil]
+      end
+    end
+
+    class Long
+      # @private
+      def self.define_plan(param)
+        [self, {:nchar => (param.charset_form == :nchar)}.freeze]
+      end
     end
 
     # get/set Date
@@ -56,6 +141,12 @@ class OCI8
     # get/set Number (for OCI8::SQLT_NUM)
     class Number
       def self.create(con, val, param, max_array_size)
+        klass, param = define_plan(param)
+        klass.new(con, val, param, max_array_size)
+      end
+
+      # @private
+      def self.define_plan(param)
         if param.is_a? OCI8::Metadata::Base
           precision = param.precision
           scale = param.scale
@@ -87,7 +178,7 @@ class OCI8
             klass = OCI8::BindType::BigDecimal
           end
         end
-        klass.new(con, val, nil, max_array_size)
+        [klass, nil]
       end
     end
 
@@ -100,6 +191,7 @@ class OCI8
       end
 
       def self.minimum_bind_length=(val)
+        DefinePlans.clear
         @@minimum_bind_length = val
       end
 
@@ -129,27 +221,33 @@ class OCI8
           # use the default value when :nchar is not set explicitly.
           param[:nchar] = OCI8.properties[:bind_string_as_nchar] unless param.has_key?(:nchar)
         when OCI8::Metadata::Base
-          case param.data_type
-          when :char, :varchar2
-            length_semantics = OCI8.properties[:length_semantics]
-            if length_semantics == :char
-              length = param.char_size
-            else
-              length = param.data_size * OCI8.nls_ratio
-            end
-            param = {
-              :length => length,
-              :length_semantics => length_semantics,
-              :nchar => (param.charset_form == :nchar),
-            }
-          when :raw
-            # HEX needs twice space.
-            param = {:length => param.data_size * 2}
+          param = define_plan(param)[1]
+        end
+        self.new(con, val, param, max_array_size)
+      end
+
+      # @private
+      def self.define_plan(param)
+        case param.data_type
+        when :char, :varchar2
+          length_semantics = OCI8.properties[:length_semantics]
+          if length_semantics == :char
+            length = param.char_size
           else
-            param = {:length => @@minimum_bind_length}
+            length = param.data_size * OCI8.nls_ratio
           end
+          param = {
+            :length => length,
+            :length_semantics => length_semantics,
+            :nchar => (param.charset_form == :nchar),
+          }
+        when :raw
+          # HEX needs twice space.
+          param = {:length => param.data_size * 2}
+        else
+          param = {:length => @@minimum_bind_length}
         end
-        self.new(con, val, param, max_array_size)
+        [self, param.freeze]
       end
     end
 
@@ -166,10 +264,15 @@ class OCI8
             end
           end
         when OCI8::Metadata::Base
-          param = {:length => param.data_size}
+          param = define_plan(param)[1]
         end
         self.new(con, val, param, max_array_size)
       end
+
+      # @private
+      def self.define_plan(param)
+        [self, {:length => param.data_size}.freeze]
+      end
     end
 
     class CLOB
@@ -180,6 +283,15 @@ class OCI8
           OCI8::BindType::CLOB.new(con, val, nil, max_array_size)
         end
       end
+
+      # @private
+      def self.define_plan(param)
+        if param.charset_form == :nchar
+          [OCI8::BindType::NCLOB, nil]
+        else
+          [OCI8::BindType::CLOB, nil]
+        end
+      end
     end
   end # BindType
 end
@@ -175,5 +175,142 @@ class OCI8
     def destroy
       free
     end
+
+    # The default number of bytes read by a network round trip in
+    # {#parallel_lob_read}.
+    #
+    # @since 2.2.15
+    PARALLEL_LOB_READ_PIECE_SIZE = 1024 * 1024
+
+    # Reads a BLOB or a BFILE by several sessions in parallel.
+    #
+    # The LOB is split into +:threads+ byte ranges. Each range is
+    # read by its own session created from the pool in its own
+    # thread. Sessions created from a connection pool are in
+    # non-blocking mode, which releases the GVL while waiting for
+    # the server. So ranges are transferred concurrently over
+    # separate physical connections. This is useful when a single
+    # session is latency-bound, e.g. on a WAN link.
+    #
+    # As LOB locators cannot be shared among sessions, the block
+    # is called once per session to get the LOB to be read.
+    # It must return the same LOB for all sessions.
+    #
+    # @example
+    #   # read a BFILE
+    #   data = cpool.parallel_lob_read(username, password, :threads => 4) do |conn|
+    #     OCI8::BFILE.new(conn, 'DATA_DIR', 'large.bin')
+    #   end
+    #
+    #   # write a BLOB to a file
+    #   File.open('large.bin', 'wb') do |f|
+    #     cpool.parallel_lob_read(username, password, :io => f) do |conn|
+    #       conn.select_one('SELECT data FROM files WHERE rowid = :1', rowid)[0]
+    #     end
+    #   end
+    #
+    # @param [String] username
+    # @param [String] password
+    # @param [Hash] options
+    # @option options [Integer] :threads (4) the number of sessions
+    # @option options [IO] :io an IO object to which data are written
+    #   by <code>pwrite</code> at their offsets. When it isn't specified,
+    #   data are returned as a String.
+    # @option options [Integer] :piece_size (1048576) the number of
+    #   bytes read by a network round trip
+    # @yieldparam [OCI8] conn a session created from the pool
+    # @yieldreturn [OCI8::BLOB or OCI8::BFILE]
+    # @return [String or Integer] data read or the number of bytes
+    #   written to +:io+
+    #
+    # @since 2.2.15
+    def parallel_lob_read(username, password, options = {})
+      raise ArgumentError, "no block given" unless block_given?
+      num_threads = (options[:threads] || 4).to_i
+      piece_size = (options[:piece_size] || PARALLEL_LOB_READ_PIECE_SIZE).to_i
+      io = options[:io]
+      raise ArgumentError, "threads must be positive" if num_threads <= 0
+      raise ArgumentError, "piece_size must be positive" if piece_size <= 0
+
+      conn = OCI8.new(username, password, self)
+      begin
+        lob = yield(conn)
+        if lob.is_a?(OCI8::CLOB) || lob.is_a?(OCI8::NCLOB)
+          # offsets of CLOBs are in characters, which cannot be
+          # mapped to byte offsets of the result.
+          raise TypeError, "#{lob.class} is not supported. Use BLOB or BFILE"
+        end
+        size = lob.size
+        # split the LOB by multiples of piece_size.
+        num_pieces = (size + piece_size - 1) / piece_size
+        num_threads = num_pieces if num_threads > num_pieces
+        ranges = []
+        num_threads.times do |i|
+          first = num_pieces * i / num_threads * piece_size
+          last = [num_pieces * (i + 1) / num_threads * piece_size, size].min
+          ranges << [first, last]
+        end
+        # The first range is read by this thread.
+        threads = ranges[1..-1].to_a.map do |first, last|
+          Thread.new do
+            c = OCI8.new(username, password, self)
+            begin
+              parallel_lob_read_range(yield(c), first, last, piece_size, io)
+            ensure
+              c.logoff
+            end
+          end
+        end
+        begin
+          results = []
+          results << parallel_lob_read_range(lob, ranges[0][0], ranges[0][1], piece_size, io) unless ranges.empty?
+        ensure
+          # wait for all threads before raising an exception.
+          errors = []
+          threads.each do |thr|
+            begin
+              results << thr.value
+            rescue Exception
+              errors << $!
+            end
+          end
+        end
+        raise errors[0] unless errors.empty?
+        io ? size : results.join
+      ensure
+        conn.logoff
+      end
+    end
+
+    private
+
+    # Reads +lob+ from +first+ to +last+ (exclusive) and writes the
+    # data to +io+ at the same offsets when +io+ is given.
+    # This raises an exception when the LOB ends before +last+,
+    # e.g. when it is truncated while being read.
+    def parallel_lob_read_range(lob, first, last, piece_size, io)
+      result = String.new
+      buf = String.new
+      pos = first
+      begin
+        lob.seek(pos)
+        while pos < last
+          data = lob.read([piece_size, last - pos].min, buf)
+          break if data.nil? || data.empty?
+          if io
+            io.pwrite(data, pos)
+          else
+            result << data
+          end
+          pos += data.bytesize
+        end
+      ensure
+        lob.close
+      end
+      if pos < last
+        raise RuntimeError, "unexpected end of LOB at #{pos} bytes (expected #{last} bytes)"
+      end
+      result.force_encoding('ASCII-8BIT')
+    end
   end
 end
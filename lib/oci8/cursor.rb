@@ -21,13 +21,22 @@ class OCI8
     def initialize(conn, sql = nil)
       @bind_handles = {}
       @define_handles = []
-      @column_metadata = []
+      @define_params = []
+      @column_metadata = nil
+      @column_count = nil
       @names = nil
       @con = conn
       @max_array_size = nil
       @fetch_array_size = nil
       @rowbuf_size = 0
       @rowbuf_index = 0
+      @fetch_buffer_size = OCI8.properties[:fetch_buffer_size]
+      @intern_strings = false
+      @lob_prefetch_size = nil
+      @lob_as_string = false
+      @reuse_lobs = false
+      @user_defined = false
+      @sql = sql
       __initialize(conn, sql) # Initialize the internal C structure.
       self.prefetch_rows = conn.instance_variable_get(:@prefetch_rows)
     end
@@ -42,12 +51,15 @@ class OCI8
     #   cursor.define(2, Time)       # fetch the second column as Time.
     #   cursor.exec()
     def define(pos, type, length = nil)
-      bindobj = make_bind_object({:type => type, :length => length}, @fetch_array_size || 1)
+      param = {:type => type, :length => length}
+      bindobj = make_define_object(param, @fetch_array_size || 1)
       __define(pos, bindobj)
       if old = @define_handles[pos - 1]
         old.send(:free)
       end
       @define_handles[pos - 1] = bindobj
+      @define_params[pos - 1] = param
+      @user_defined = true
       self
     end
 
@@ -129,10 +141,10 @@ class OCI8
       case type
       when :select_stmt
         __execute(0)
-        define_columns() if @column_metadata.size == 0
+        define_columns() if @column_count.nil?
         @rowbuf_size = 0
         @rowbuf_index = 0
-        @column_metadata.size
+        @column_count
       else
         __execute(1)
         row_count
@@ -177,6 +189,62 @@ class OCI8
       end
     end
 
+    # Gets at most +max_rows+ fetched rows column by column.
+    # It returns an array of columns. Each column is an array
+    # of values in the column. This is available for select
+    # statement only.
+    #
+    # When the define handles are not large enough to hold +max_rows+
+    # rows before the first fetch, they are reallocated so that
+    # +max_rows+ rows are fetched in one network round trip.
+    #
+    # When +packed+ is true, numeric columns defined as
+    # {OCI8::BindType::OraNumber}, {OCI8::BindType::Integer} or
+    # {OCI8::BindType::Float} and their subclasses are returned as
+    # a pair of packed binary values and a null bitmap made by
+    # OCI8::BindType::OraNumber#get_packed_data. Integer columns are
+    # packed as 64-bit integers and others as doubles.
+    #
+    # @example
+    #   cursor = conn.exec('SELECT empno, ename FROM emp')
+    #   while cols = cursor.fetch_columns(1000)
+    #     empnos, enames = cols
+    #     ...
+    #   end
+    #   cursor.close
+    #
+    # @example packed numeric columns
+    #   cursor = conn.parse('SELECT empno, sal FROM emp')
+    #   cursor.define(1, Integer)
+    #   cursor.define(2, Float)
+    #   cursor.exec
+    #   (empnos, empno_nulls), (sals, sal_nulls) = cursor.fetch_columns(1000, true)
+    #   empnos.unpack('q*')
+    #   sals.unpack('d*')
+    #
+    # @param [Integer] max_rows the maximum number of rows
+    # @param [Boolean] packed
+    # @return [Array of Array] or nil when all rows are fetched.
+    #
+    # @since 2.2.15
+    def fetch_columns(max_rows, packed = false)
+      max_rows = max_rows.to_i
+      raise ArgumentError, "max_rows must be positive" if max_rows <= 0
+      if @rowbuf_size == 0 && (@fetch_array_size || 1) < max_rows
+        resize_define_handles(max_rows)
+      end
+      packed_types = packed ? packed_column_types : nil
+      columns = nil
+      while max_rows > 0 && fetch_row_internal
+        nrows = @rowbuf_size - @rowbuf_index
+        nrows = max_rows if nrows > max_rows
+        columns = __fetch_columns(@rowbuf_index, nrows, columns, packed_types)
+        @rowbuf_index += nrows
+        max_rows -= nrows
+      end
+      columns
+    end
+
     # Gets the value of the bind variable.
     #
     # When bind variables are explicitly bound by {OCI8::Cursor#bind_param},
@@ -325,11 +393,17 @@ class OCI8
     end
 
     # Executes the SQL statement assigned the cursor with array binding
-    def exec_array
+    #
+    # When +batch_errors+ is true, rows which cause errors don't stop
+    # the execution. Other rows are processed and the errors are got
+    # by {#batch_errors}.
+    #
+    # @param [Boolean] batch_errors  (since 2.2.15)
+    def exec_array(batch_errors = false)
       raise "please call max_array_size= first." if @max_array_size.nil?
 
       if !@actual_array_size.nil? && @actual_array_size > 0
-        __execute(@actual_array_size)
+        __execute(@actual_array_size, batch_errors)
       else
         raise "please set non-nil values to array binding parameters"
       end
@@ -342,10 +416,71 @@ class OCI8
       end
     end
 
+    # Executes the SQL statement assigned the cursor with columns of
+    # values. This is same with setting each column by
+    # {#bind_param_array} and calling {#exec_array} except that bind
+    # handles made by {#bind_param_array} are reused and values are
+    # set without calling ruby methods per value unless +set+ is
+    # overridden in ruby.
+    #
+    # Bind variables must be bound by position. The n-th column is
+    # set to the bind variable at position n. When +packed+ is true,
+    # columns bound as Integer, Float and OraNumber are passed as
+    # pairs of packed values and null bitmaps as those got by
+    # {#fetch_columns}. The null bitmap may be +nil+ when
+    # there are no NULL values.
+    #
+    # @example
+    #   cursor = conn.parse("INSERT INTO test_table VALUES (:id, :name)")
+    #   cursor.max_array_size = 3
+    #   cursor.bind_param_array(1, nil, Integer)
+    #   cursor.bind_param_array(2, nil, String, 30)
+    #   cursor.exec_columns([[1, 2, 3], ['happy', 'new', 'year']])
+    #   cursor.exec_columns([[[4, 5].pack('q*'), nil], ['foo', 'bar']], true)
+    #
+    # @param [Array] columns  columns of values
+    # @param [Boolean] packed  true to pass numeric columns as packed strings
+    # @param [Boolean] batch_errors  passed to {#exec_array}
+    # @return [Integer] the number of rows processed for DML statements
+    #
+    # @since 2.2.15
+    def exec_columns(columns, packed = false, batch_errors = false)
+      raise "please call max_array_size= first." if @max_array_size.nil?
+      keys = @bind_handles.keys
+      unless keys.all? { |key| key.is_a? Integer }
+        raise ArgumentError, "bind variables must be bound by position to use exec_columns"
+      end
+      keys.sort!
+      if columns.size != keys.size
+        raise ArgumentError, "wrong number of columns (#{columns.size} for #{keys.size})"
+      end
+      handles = keys.collect { |key| @bind_handles[key] }
+      packed_types = packed ? packed_column_types(handles) : []
+      # Check sizes of all columns before any handle is changed.
+      num_rows = nil
+      columns.each_with_index do |column, i|
+        size = packed_types[i] ? column[0].bytesize / 8 : column.size
+        raise "all binding arrays should be the same size." unless num_rows.nil? || num_rows == size
+        num_rows = size
+      end
+      if num_rows && num_rows > @max_array_size
+        raise "the size of columns should not be greater than max_array_size."
+      end
+      columns.each_with_index do |column, i|
+        if packed_types[i]
+          handles[i].send(:set_packed_data, packed_types[i], column[0], column[1])
+        else
+          handles[i].send(:set_data, column)
+        end
+      end
+      @actual_array_size = num_rows
+      exec_array(batch_errors)
+    end
+
     # Gets the names of select-list as array. Please use this
     # method after exec.
     def get_col_names
-      @names ||= @column_metadata.collect { |md| md.name }
+      @names ||= column_metadata.collect { |md| md.name }
     end
 
     # Gets an array of OCI8::Metadata::Column of a select statement.
@@ -364,14 +499,21 @@ class OCI8
     #
     # @since 1.0.0
     def column_metadata
-      @column_metadata
+      return [] if @column_count.nil?
+      @column_metadata ||= 1.upto(@column_count).collect do |i|
+        __paramGet(i)
+      end
     end
 
     # close the cursor.
+    #
+    # When {OCI8.properties}[:cursor_cache_size] is positive, the
+    # statement handle is moved to a new cursor kept by the connection
+    # instead of being freed. It is reused by {OCI8#parse} and
+    # {OCI8#exec} with the same SQL text. +self+ is closed in either case.
     def close
-      free()
-      @names = nil
-      @column_metadata = nil
+      return if @sql && @con.send(:cache_cursor, self, @sql)
+      close_internal
     end
 
     # Returns the keys of bind variables.
@@ -389,10 +531,194 @@ class OCI8
     #
     # @param [Integer] rows The number of rows to be prefetched
     def prefetch_rows=(rows)
-      attr_set_ub4(11, rows) # OCI_ATTR_PREFETCH_ROWS(11)
+      self.__prefetch_rows = rows
       @prefetch_rows = rows
     end
 
+    # Set the memory budget in bytes to fetch rows. When it is set,
+    # rows are always fetched by array fetching. The number of rows
+    # fetched at once starts from the number of prefetch rows, is
+    # doubled up to five times while full batches are fetched and
+    # doesn't exceed the number calculated from the budget and the
+    # size of a row.
+    # When it is +nil+, rows are fetched one by one unless the
+    # select list contains LOB columns.
+    #
+    # The default value is {OCI8.properties}[:fetch_buffer_size].
+    #
+    # @param [Integer] size The memory budget in bytes or +nil+
+    #
+    # @since 2.2.15
+    def fetch_buffer_size=(size)
+      if !size.nil?
+        size = size.to_i
+        raise ArgumentError, "fetch_buffer_size must be nil or a positive integer." if size <= 0
+      end
+      @fetch_buffer_size = size
+    end
+
+    # Returns the memory budget to fetch rows.
+    #
+    # @return [Integer or nil]
+    #
+    # @since 2.2.15
+    attr_reader :fetch_buffer_size
+
+    # When +val+ is true, fetched CHAR, VARCHAR2, NCHAR and NVARCHAR2
+    # values are returned as frozen and deduplicated strings.
+    # A same string object is returned for same values. This reduces
+    # memory usage and string allocations for columns which have
+    # a few distinct values such as status codes and country codes.
+    #
+    # The strings are deduplicated by +rb_enc_interned_str()+ when
+    # it is available (ruby 3.0 or later). Otherwise they are only
+    # frozen.
+    #
+    # @example
+    #   cursor = conn.parse('SELECT status, country_code FROM orders')
+    #   cursor.intern_strings = true
+    #   cursor.exec
+    #
+    # @param [Boolean] val
+    #
+    # @since 2.2.15
+    def intern_strings=(val)
+      @intern_strings = val ? true : false
+      @define_handles.each do |handle|
+        handle.send(:intern_strings=, @intern_strings) if handle.is_a?(OCI8::BindType::String)
+      end
+    end
+
+    # Returns +true+ when fetched strings are frozen and deduplicated.
+    #
+    # @return [Boolean]
+    #
+    # @since 2.2.15
+    def intern_strings?
+      @intern_strings
+    end
+
+    # Set the LOB prefetch size in characters for CLOB and NCLOB or
+    # in bytes for BLOB. When it is set, the length and the first
+    # +size+ characters or bytes of CLOB, NCLOB and BLOB columns are
+    # prefetched along with LOB locators. LOB values not longer than
+    # +size+ are returned as String instead of {OCI8::LOB} objects
+    # without extra network round trips. Longer values are returned
+    # as {OCI8::LOB} objects as before.
+    #
+    # This must be set before the first fetch. Set +nil+ to disable it.
+    # This is available on Oracle 11.1 client or upper.
+    #
+    # @example
+    #   cursor = conn.parse('SELECT id, message FROM audit_logs')
+    #   cursor.lob_prefetch_size = 4000
+    #   cursor.exec
+    #   cursor.fetch # => [1, "message text"]
+    #
+    # @param [Integer] size
+    #
+    # @since 2.2.15
+    def lob_prefetch_size=(size)
+      if !size.nil?
+        if OCI8.oracle_client_version < OCI8::ORAVER_11_1
+          raise "LOB prefetch is not supported on Oracle version #{OCI8.oracle_client_version}"
+        end
+        size = size.to_i
+        raise ArgumentError, "lob_prefetch_size must be nil or a positive integer." if size <= 0
+      end
+      @lob_prefetch_size = size
+      @define_handles.each do |handle|
+        set_lob_prefetch_size(handle)
+      end
+    end
+
+    # Returns the LOB prefetch size.
+    #
+    # @return [Integer or nil]
+    #
+    # @since 2.2.15
+    attr_reader :lob_prefetch_size
+
+    # When +val+ is true, CLOB and NCLOB columns are fetched as String
+    # and BLOB columns as binary String in the same way with LONG and
+    # LONG RAW columns. The values are transferred along with rows
+    # instead of LOB locators. So no extra network round trips are
+    # required to read them. It is useful when all values are read
+    # immediately after they are fetched.
+    #
+    # Note that whole values are held in memory. When +val+ is an
+    # Integer, it is the maximum size of each value in bytes and
+    # fetching a larger value raises a RuntimeError instead of
+    # truncating it.
+    # BFILE columns are fetched as {OCI8::BFILE} regardless of this.
+    #
+    # @example
+    #   cursor = conn.parse('SELECT id, document FROM documents')
+    #   cursor.lob_as_string = 1024 * 1024 # up to 1 megabyte per value
+    #   cursor.exec
+    #   cursor.fetch # => [1, "contents of the document"]
+    #
+    # @param [Boolean or Integer] val
+    #
+    # @since 2.2.15
+    def lob_as_string=(val)
+      if val.is_a? Integer
+        raise ArgumentError, "max size must be positive" if val <= 0
+      else
+        val = val ? true : false
+      end
+      if @lob_as_string != val
+        @lob_as_string = val
+        # redefine columns already defined.
+        resize_define_handles(@fetch_array_size || 1) if @define_handles.size > 0
+      end
+    end
+
+    # Returns +true+ when LOB columns are fetched as String.
+    #
+    # @return [Boolean]
+    #
+    # @since 2.2.15
+    def lob_as_string?
+      @lob_as_string ? true : false
+    end
+
+    # When +val+ is true, CLOB, NCLOB and BLOB objects fetched by this
+    # cursor are reused by the next fetch instead of creating new LOB
+    # locators for each row. This reduces object allocations and locator
+    # copies when many LOB columns are scanned.
+    #
+    # Fetched LOB objects are valid only until the next fetch, or the
+    # next array fetch when rows are fetched by array fetching.
+    # Use {OCI8::LOB#dup} to keep them.
+    #
+    # @example
+    #   cursor = conn.parse('SELECT document FROM documents')
+    #   cursor.reuse_lobs = true
+    #   cursor.exec
+    #   while row = cursor.fetch
+    #     process(row[0].read)
+    #   end
+    #
+    # @param [Boolean] val
+    #
+    # @since 2.2.15
+    def reuse_lobs=(val)
+      @reuse_lobs = val ? true : false
+      @define_handles.each do |handle|
+        set_reuse_lobs(handle)
+      end
+    end
+
+    # Returns +true+ when fetched LOB objects are reused.
+    #
+    # @return [Boolean]
+    #
+    # @since 2.2.15
+    def reuse_lobs?
+      @reuse_lobs
+    end
+
     if OCI8::oracle_client_version >= ORAVER_12_1
       # Returns the number of processed rows.
       #
@@ -475,6 +801,71 @@ class OCI8
 
     private
 
+    def close_internal
+      free()
+      @names = nil
+      @column_metadata = nil
+      @column_count = nil
+      @sql = nil
+    end
+
+    # Instance variables moved by {#detach}. Add new ones here when
+    # they are needed to reuse a cached cursor.
+    #
+    # @private
+    DETACHED_IVARS = [
+      :@bind_handles, :@define_handles, :@define_params,
+      :@column_metadata, :@column_count, :@names, :@con, :@sql,
+      :@max_array_size, :@actual_array_size, :@fetch_array_size,
+      :@rowbuf_size, :@rowbuf_index, :@fetch_buffer_size,
+      :@prefetch_rows, :@intern_strings, :@lob_prefetch_size,
+      :@lob_as_string, :@reuse_lobs, :@user_defined,
+    ].freeze
+
+    # Moves the statement handle to a new cursor to be kept in the
+    # cursor cache and closes +self+. This returns +nil+ when +self+
+    # is already closed.
+    def detach
+      cursor = __detach
+      return nil if cursor.nil?
+      DETACHED_IVARS.each do |name|
+        cursor.instance_variable_set(name, instance_variable_get(name))
+      end
+      @bind_handles = {}
+      @define_handles = []
+      @define_params = []
+      @names = nil
+      @column_metadata = nil
+      @column_count = nil
+      @sql = nil
+      cursor
+    end
+
+    # Resets per-use settings of a cursor taken from the cursor cache.
+    # Bind handles are freed to raise ORA-01008 when some variables
+    # aren't bound. Column metadata and define handles are kept to skip
+    # describing and defining columns again unless columns are defined
+    # by {#define}.
+    def reset_for_reuse
+      free_bind_handles
+      @max_array_size = nil
+      @actual_array_size = nil
+      free_define_handles if @user_defined
+      @rowbuf_size = 0
+      @rowbuf_index = 0
+      @fetch_buffer_size = OCI8.properties[:fetch_buffer_size]
+      if @intern_strings || @lob_prefetch_size || @lob_as_string || @reuse_lobs
+        @intern_strings = false
+        @lob_prefetch_size = nil
+        @lob_as_string = false
+        @reuse_lobs = false
+        # redefine columns once to drop the settings from define handles.
+        resize_define_handles(@fetch_array_size || 1) if @define_handles.size > 0
+      end
+      prefetch_rows = @con.instance_variable_get(:@prefetch_rows)
+      self.prefetch_rows = prefetch_rows if @prefetch_rows != prefetch_rows
+    end
+
     def make_bind_object(param, fetch_array_size = nil)
       case param
       when Hash
@@ -520,36 +911,128 @@ class OCI8
       bindclass.create(@con, val, param, fetch_array_size || max_array_size)
     end
 
+    def packed_column_types(handles = @define_handles)
+      handles.collect do |handle|
+        case handle
+        when OCI8::BindType::Integer
+          :int64
+        when OCI8::BindType::OraNumber, OCI8::BindType::Float
+          :double
+        end
+      end
+    end
+
+    # Define plans to fetch LOB columns as String.
+    @@lob_as_string_plans = {
+      OCI8::BindType::CLOB => [OCI8::BindType::Long, {:nchar => false}.freeze].freeze,
+      OCI8::BindType::NCLOB => [OCI8::BindType::Long, {:nchar => true}.freeze].freeze,
+      OCI8::BindType::BLOB => [OCI8::BindType::LongRaw, nil].freeze,
+    }
+
+    def make_define_object(param, fetch_array_size)
+      if param.is_a? Array
+        # a pair of a bind class and its parameter in a define plan
+        if @lob_as_string && (plan = @@lob_as_string_plans[param[0]])
+          param = plan
+          if @lob_as_string.is_a? Integer
+            param = [plan[0], (plan[1] || {}).merge(:max_size => @lob_as_string)]
+          end
+        end
+        bindobj = param[0].new(@con, nil, param[1], fetch_array_size)
+      else
+        bindobj = make_bind_object(param, fetch_array_size)
+      end
+      bindobj.send(:intern_strings=, true) if @intern_strings && bindobj.is_a?(OCI8::BindType::String)
+      set_reuse_lobs(bindobj) if @reuse_lobs
+      bindobj
+    end
+
     @@use_array_fetch = false
 
     def define_columns
       # http://docs.oracle.com/cd/E11882_01/appdev.112/e10646/ociaahan.htm#sthref5494
       num_cols = attr_get_ub4(18) # OCI_ATTR_PARAM_COUNT(18)
-      @column_metadata = 1.upto(num_cols).collect do |i|
-        __paramGet(i)
-      end
+      @column_metadata = nil
+      @column_count = num_cols
+      use_lob, params = define_plan(num_cols)
       if @define_handles.size == 0
-        use_array_fetch = @@use_array_fetch
-        @column_metadata.each do |md|
-          case md.data_type
-          when :clob, :blob, :bfile
-            # Rows prefetching doesn't work for CLOB, BLOB and BFILE.
-            # Use array fetching to get more than one row in a network round trip.
-            use_array_fetch = true
-          end
-        end
-        @fetch_array_size = @prefetch_rows if use_array_fetch
+        # Rows prefetching doesn't work for CLOB, BLOB and BFILE.
+        # Use array fetching to get more than one row in a network round trip.
+        @fetch_array_size = @prefetch_rows if @@use_array_fetch || use_lob
       end
-      @column_metadata.each_with_index do |md, i|
-        define_one_column(i + 1, md) unless @define_handles[i]
+      params.each_with_index do |param, i|
+        define_one_column(i + 1, param) unless @define_handles[i]
       end
       num_cols
     end
 
+    # Returns a pair of a flag whether LOB columns are included and
+    # parameters passed to make_define_object for each column.
+    #
+    # The plan is cached per the binary description of the columns
+    # got by __column_descs. Cached plans consist of bind classes and
+    # frozen hashes only. So the column metadata are created only when
+    # a new shape of columns is found or when it includes named types.
+    def define_plan(num_cols)
+      descs = __column_descs(num_cols)
+      plan = OCI8::BindType::DefinePlans[descs]
+      return plan if plan
+
+      use_lob = false
+      cacheable = true
+      params = column_metadata.collect do |md|
+        key = md.data_type
+        case key
+        when :clob, :blob, :bfile
+          use_lob = true
+        when :named_type
+          # The type name isn't in the description.
+          cacheable = false
+          next md
+        end
+        bindclass = OCI8::BindType::Mapping[key]
+        raise "unsupported datatype: #{key}" if bindclass.nil?
+        bindclass.define_plan(md)
+      end
+      plan = [use_lob, params]
+      OCI8::BindType::DefinePlans[descs] = plan if cacheable
+      plan
+    end
+
+    # The LOB prefetch size is an attribute of a define handle.
+    # So it is set after the define handle is created by __define.
+    def set_lob_prefetch_size(handle)
+      case handle
+      when OCI8::BindType::CLOB, OCI8::BindType::NCLOB, OCI8::BindType::BLOB
+        handle.send(:lob_prefetch_size=, @lob_prefetch_size || 0)
+      end
+    end
+
+    def set_reuse_lobs(handle)
+      case handle
+      when OCI8::BindType::CLOB, OCI8::BindType::NCLOB, OCI8::BindType::BLOB
+        handle.send(:reuse_lobs=, @reuse_lobs)
+      end
+    end
+
     def define_one_column(pos, param)
-      bindobj = make_bind_object(param, @fetch_array_size || 1)
+      bindobj = make_define_object(param, @fetch_array_size || 1)
       __define(pos, bindobj)
+      set_lob_prefetch_size(bindobj) if @lob_prefetch_size
       @define_handles[pos - 1] = bindobj
+      @define_params[pos - 1] = param
+    end
+
+    # Redefines all columns to fetch +fetch_array_size+ rows at once.
+    def resize_define_handles(fetch_array_size)
+      @fetch_array_size = fetch_array_size
+      @define_params.each_with_index do |param, i|
+        bindobj = make_define_object(param, fetch_array_size)
+        __define(i + 1, bindobj)
+        set_lob_prefetch_size(bindobj) if @lob_prefetch_size
+        @define_handles[i].send(:free)
+        @define_handles[i] = bindobj
+      end
     end
 
     def bind_params(*bindvars)
@@ -564,17 +1047,44 @@ class OCI8
 
     def fetch_row_internal
       if @rowbuf_size && @rowbuf_size == @rowbuf_index
+        adjust_fetch_array_size if @fetch_buffer_size
         @rowbuf_size = __fetch(@con, @fetch_array_size || 1)
         @rowbuf_index = 0
       end
       @rowbuf_size
     end
 
+    # The maximum number of times the fetch array is enlarged per execution.
+    # Define handles are rebuilt each time.
+    #
+    # @private
+    MAX_FETCH_ARRAY_GROWTH = 5
+
+    # Changes the fetch array size before fetching next rows when
+    # @fetch_buffer_size is set. It is doubled only when the previous
+    # fetch returned a full batch, at most MAX_FETCH_ARRAY_GROWTH
+    # times per execution, and is limited by the memory budget.
+    def adjust_fetch_array_size
+      current_size = @fetch_array_size || 1
+      if @rowbuf_size == 0
+        # the first fetch after execution
+        @fetch_array_growth = 0
+        new_size = @fetch_array_size || @prefetch_rows || 1
+      elsif @rowbuf_size == current_size && @fetch_array_growth < MAX_FETCH_ARRAY_GROWTH
+        @fetch_array_growth += 1
+        new_size = current_size * 2
+      else
+        new_size = current_size
+      end
+      max_size = @fetch_buffer_size / __define_row_size
+      new_size = max_size if new_size > max_size
+      new_size = 1 if new_size < 1
+      resize_define_handles(new_size) if new_size != current_size
+    end
+
     def fetch_one_row_as_array
       if fetch_row_internal
-        ret = @define_handles.collect do |handle|
-          handle.send(:get_data, @rowbuf_index)
-        end
+        ret = __fetch_row_as_array(@rowbuf_index)
         @rowbuf_index += 1
         ret
       else
@@ -584,9 +1094,10 @@ class OCI8
 
     def fetch_one_row_as_hash
       if fetch_row_internal
+        row = __fetch_row_as_array(@rowbuf_index)
         ret = {}
         get_col_names.each_with_index do |name, idx|
-          ret[name] = @define_handles[idx].send(:get_data, @rowbuf_index)
+          ret[name] = row[idx]
         end
         @rowbuf_index += 1
         ret
@@ -601,5 +1112,18 @@ class OCI8
       end
       @bind_handles.clear
     end
+
+    def free_define_handles
+      @define_handles.each do |val|
+        val.send(:free) if val
+      end
+      @define_handles = []
+      @define_params = []
+      @names = nil
+      @column_metadata = nil
+      @column_count = nil
+      @fetch_array_size = nil
+      @user_defined = false
+    end
   end
 end
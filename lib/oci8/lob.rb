@@ -0,0 +1,286 @@
+#--
+# lob.rb -- OCI8::LOB::BufferedReader
+#
+# Copyright (C) 2024 Kubo Takehiro <kubo@jiubao.org>
+#++
+
+#
+class OCI8
+
+  class LOB
+
+    # Returns a buffered reader of the LOB.
+    #
+    # @param [Integer] buffer_size see {OCI8::LOB::BufferedReader#initialize}
+    # @return [OCI8::LOB::BufferedReader]
+    #
+    # @since 2.2.15
+    def to_io(buffer_size = nil)
+      BufferedReader.new(self, buffer_size)
+    end
+
+    # An IO-like reader of a LOB with a read-ahead buffer.
+    #
+    # {OCI8::LOB#read} requires a network round trip per call. This
+    # reads data by a multiple of {OCI8::LOB#chunk_size} and serves
+    # small reads such as <code>gets</code> and <code>read(4096)</code>
+    # from the buffer. So it can be passed to libraries reading IO
+    # objects, such as CSV.
+    #
+    # Lengths and positions are in characters for {OCI8::CLOB} and
+    # {OCI8::NCLOB} and in bytes for {OCI8::BLOB} and {OCI8::BFILE}
+    # as {OCI8::LOB#read}.
+    #
+    # @example
+    #   clob = conn.select_one('SELECT csv_data FROM uploads WHERE id = 1')[0]
+    #   CSV.new(clob.to_io).each do |row|
+    #     ...
+    #   end
+    #
+    # @since 2.2.15
+    class BufferedReader
+      include Enumerable
+
+      # The default minimum size of the read-ahead buffer.
+      DEFAULT_BUFFER_SIZE = 32 * 1024
+
+      # Returns the line number.
+      #
+      # @return [Integer]
+      attr_accessor :lineno
+
+      # Creates a buffered reader of +lob+. Data are read from the
+      # current position of +lob+.
+      #
+      # @param [OCI8::LOB] lob
+      # @param [Integer] buffer_size the number of characters or bytes
+      #   read at once. When it is +nil+, the smallest multiple of
+      #   {OCI8::LOB#chunk_size} not less than 32768 is used.
+      def initialize(lob, buffer_size = nil)
+        @lob = lob
+        @buffer_size = buffer_size ? buffer_size.to_i : default_buffer_size
+        raise ArgumentError, "buffer_size must be positive" if @buffer_size <= 0
+        @buf = String.new
+        @eof = false
+        @lineno = 0
+      end
+
+      # Reads +length+ characters or bytes. When +length+ is +nil+,
+      # it reads data until EOF.
+      #
+      # @param [Integer] length
+      # @param [String] outbuf
+      # @return [String or nil] +nil+ at EOF when +length+ is positive.
+      def read(length = nil, outbuf = nil)
+        if length.nil?
+          fill_buffer until @eof
+          str = take(@buf.size)
+        else
+          length = length.to_i
+          raise ArgumentError, "negative length #{length} given" if length < 0
+          fill_buffer while !@eof && @buf.size < length
+          return nil if length > 0 && @buf.empty?
+          str = take(length)
+        end
+        outbuf ? outbuf.replace(str) : str
+      end
+
+      # Reads at most +maxlen+ characters or bytes. It reads data
+      # from the LOB only when the buffer is empty.
+      #
+      # @param [Integer] maxlen
+      # @param [String] outbuf
+      # @return [String]
+      # @raise [EOFError] at EOF
+      def readpartial(maxlen, outbuf = nil)
+        fill_buffer if @buf.empty?
+        raise EOFError, "end of file reached" if @buf.empty? && maxlen > 0
+        str = take(maxlen)
+        outbuf ? outbuf.replace(str) : str
+      end
+
+      # Reads the next line. The arguments are same with IO#gets
+      # except the paragraph mode.
+      #
+      # @overload gets(sep = $/, limit = nil)
+      # @overload gets(limit)
+      # @return [String or nil] +nil+ at EOF
+      def gets(*args)
+        sep, limit = parse_line_args(*args)
+        if sep.nil? && limit.nil?
+          str = read(nil)
+          return nil if str.empty?
+          @lineno += 1
+          return str
+        end
+        fill_buffer if @buf.empty?
+        return nil if @buf.empty?
+        if sep
+          start = 0
+          while (idx = @buf.index(sep, start)).nil?
+            break if @eof || (limit && @buf.size >= limit)
+            start = [@buf.size - sep.size + 1, 0].max
+            fill_buffer
+          end
+          len = idx ? idx + sep.size : @buf.size
+        else
+          fill_buffer while !@eof && @buf.size < limit
+          len = @buf.size
+        end
+        len = limit if limit && limit < len
+        @lineno += 1
+        take(len)
+      end
+
+      # Reads the next line.
+      #
+      # @return [String]
+      # @raise [EOFError] at EOF
+      def readline(*args)
+        line = gets(*args)
+        raise EOFError, "end of file reached" if line.nil?
+        line
+      end
+
+      # Yields each line.
+      #
+      # @overload each_line(sep = $/, limit = nil)
+      # @yieldparam [String] line
+      # @return [self]
+      def each_line(*args)
+        return to_enum(:each_line, *args) unless block_given?
+        while line = gets(*args)
+          yield line
+        end
+        self
+      end
+      alias each each_line
+
+      # Returns the current position.
+      #
+      # @return [Integer]
+      def pos
+        @lob.pos - @buf.size
+      end
+      alias tell pos
+
+      # Sets the current position.
+      #
+      # @param [Integer] offset
+      # @param [Integer] whence IO::SEEK_SET, IO::SEEK_CUR or IO::SEEK_END
+      # @return [0]
+      def seek(offset, whence = ::IO::SEEK_SET)
+        case whence
+        when ::IO::SEEK_SET, :SET
+          newpos = offset
+        when ::IO::SEEK_CUR, :CUR
+          newpos = pos + offset
+        when ::IO::SEEK_END, :END
+          newpos = @lob.size + offset
+        else
+          raise ArgumentError, "unknown whence: #{whence}"
+        end
+        raise Errno::EINVAL if newpos < 0
+        @lob.seek(newpos)
+        @buf = String.new
+        @eof = false
+        0
+      end
+
+      # Sets the position to zero.
+      #
+      # @return [0]
+      def rewind
+        seek(0)
+        @lineno = 0
+        0
+      end
+
+      # Returns +true+ when the position is at EOF.
+      #
+      # @return [Boolean]
+      def eof?
+        fill_buffer if @buf.empty?
+        @buf.empty?
+      end
+      alias eof eof?
+
+      # Returns the encoding of strings read.
+      #
+      # @return [Encoding]
+      def external_encoding
+        if @lob.is_a?(OCI8::CLOB) || @lob.is_a?(OCI8::NCLOB)
+          Encoding.default_internal || OCI8.encoding
+        else
+          Encoding::ASCII_8BIT
+        end
+      end
+
+      # Closes the LOB.
+      def close
+        @lob.close
+        @buf = String.new
+        @closed = true
+        nil
+      end
+
+      # Returns +true+ when it is closed.
+      def closed?
+        @closed ? true : false
+      end
+
+      private
+
+      def default_buffer_size
+        chunk_size = @lob.is_a?(OCI8::BFILE) ? 0 : @lob.chunk_size
+        return DEFAULT_BUFFER_SIZE if chunk_size <= 0
+        (DEFAULT_BUFFER_SIZE + chunk_size - 1) / chunk_size * chunk_size
+      end
+
+      # Appends data read by a network round trip to the buffer.
+      def fill_buffer
+        return if @eof
+        data = @lob.read(@buffer_size)
+        if data.nil? || data.empty?
+          @eof = true
+        elsif @buf.empty?
+          @buf = data
+        else
+          @buf << data
+        end
+      end
+
+      def take(len)
+        if len >= @buf.size
+          str = @buf
+          @buf = String.new
+          str
+        else
+          @buf.slice!(0, len)
+        end
+      end
+
+      def parse_line_args(*args)
+        case args.size
+        when 0
+          sep = $/
+        when 1
+          if args[0].nil? || args[0].is_a?(::String)
+            sep = args[0]
+          else
+            limit = args[0]
+            sep = $/
+          end
+        when 2
+          sep, limit = args
+        else
+          raise ArgumentError, "wrong number of arguments (#{args.size} for 0..2)"
+        end
+        sep = "\n\n" if sep == ''
+        limit = limit.to_i if limit
+        limit = nil if limit && limit < 0
+        [sep, limit]
+      end
+    end
+  end
+end
@@ -94,6 +94,13 @@ class OCI8
   # or
   #   OCI8.new('proxy_user_name[end_user_name]/proxy_password')
   #
+  # === getting a session from a session pool
+  #
+  # Pass an {OCI8::SessionPool} as +dbname+. The fourth argument is
+  # the tag of the session instead of +privilege+. See {OCI8::SessionPool}.
+  #
+  #   OCI8.new(nil, nil, spool, 'NLS_DATE_FORMAT=YYYY-MM-DD')
+  #
   def initialize(*args)
     if args.length == 1
       username, password, dbname, privilege = parse_connect_string(args[0])
@@ -101,6 +108,13 @@ class OCI8
       username, password, dbname, privilege = args
     end
 
+    if dbname.is_a? OCI8::SessionPool
+      @pool = dbname # to prevent GC from freeing the session pool.
+      get_session_from_pool(username, password, dbname, privilege)
+      init_session_vars
+      return
+    end
+
     if username.nil? and password.nil?
       cred = OCI_CRED_EXT
     end
@@ -151,8 +165,54 @@ class OCI8
       attr_set_ub4(176, stmt_cache_size) # 176: OCI_ATTR_STMTCACHESIZE
     end
 
-    @prefetch_rows = 100
-    @username = nil
+    init_session_vars
+  end
+
+  # Returns the tag of the session got from an {OCI8::SessionPool}.
+  # It is +nil+ when the session isn't tagged.
+  #
+  # @return [String]
+  # @since 2.2.15
+  attr_reader :session_tag
+
+  # Returns +true+ when the session got from an {OCI8::SessionPool}
+  # has the tag requested by {OCI8#initialize}.
+  #
+  # @return [Boolean]
+  # @since 2.2.15
+  def session_tag_found?
+    @session_tag_found ? true : false
+  end
+
+  # Sets the tag of the session got from an {OCI8::SessionPool}.
+  # The session returns to the pool with this tag by {#logoff}.
+  # Set a tag describing the state of the session, such as NLS
+  # parameters changed after the session was got, to reuse the
+  # session by requests needing the same state.
+  #
+  # @example
+  #   conn = OCI8.new(nil, nil, spool, 'NLS_DATE_FORMAT=YYYY-MM-DD')
+  #   unless conn.session_tag_found?
+  #     conn.exec("ALTER SESSION SET NLS_DATE_FORMAT = 'YYYY-MM-DD'")
+  #     conn.session_tag = 'NLS_DATE_FORMAT=YYYY-MM-DD'
+  #   end
+  #   ...
+  #   conn.logoff # The session returns to the pool with the tag.
+  #
+  # @param [String] tag
+  # @since 2.2.15
+  def session_tag=(tag)
+    set_release_tag(tag)
+    @session_tag = tag
+  end
+
+  # Disconnects from the Oracle server. The uncommitted transaction is
+  # rollbacked.
+  def logoff
+    # Cursors in the cursor cache are freed by __logoff along with
+    # other cursors.
+    @cursor_cache = {}
+    __logoff
   end
 
   # Returns a prepared SQL handle.
@@ -168,6 +228,10 @@ class OCI8
   #
   # @private
   def parse_internal(sql)
+    if @cursor_cache_size > 0 and cursor = @cursor_cache.delete(sql)
+      cursor.send(:reset_for_reuse)
+      return cursor
+    end
     cursor = OCI8::Cursor.new(self, sql)
     cursor
   end
@@ -314,6 +378,72 @@ class OCI8
     return row
   end
 
+  # Inserts rows by array DML in batches of a fixed size.
+  #
+  # Each batch is executed with batch errors. Rows which cause errors
+  # are skipped and other rows in the batch are inserted. The errors
+  # are returned after all rows are processed. When a block is given,
+  # it is also called with the index of the failed row, which starts
+  # from zero, the OCIError and the row.
+  #
+  # +table_or_sql+ is an INSERT statement whose bind variables
+  # correspond to the elements of each row or a table name.
+  # When it is a table name, <code>INSERT INTO table_name VALUES
+  # (:1, :2, ...)</code> is used.
+  #
+  # The bind type of each column is the class of the first non-nil
+  # value unless it is specified by <code>:types</code>. A column
+  # whose values are all nil is bound as String until a batch
+  # including a non-nil value is found.
+  #
+  # @example
+  #   rows = CSV.foreach('emp.csv')
+  #   errors = conn.bulk_insert('emp', rows, :batch_size => 5000) do |index, err, row|
+  #     puts "#{index}: #{err.message}"
+  #   end
+  #   conn.commit
+  #
+  # @param [String] table_or_sql  table name or INSERT statement
+  # @param [Enumerable] rows  rows whose elements are arrays of values
+  # @param [Hash] options
+  # @option options [Integer] :batch_size (1000) the number of rows inserted at once
+  # @option options [Array] :types bind types of columns. +nil+ elements are guessed.
+  # @return [Array] pairs of the index of a failed row and an OCIError
+  #
+  # @since 2.2.15
+  def bulk_insert(table_or_sql, rows, options = {})
+    @last_error = nil
+    batch_size = options[:batch_size] || 1000
+    raise ArgumentError, "batch_size must be a positive integer" if batch_size <= 0
+    types = options[:types] || []
+    bind_types = []
+    errors = []
+    offset = 0
+    batch = []
+    cursor = nil
+    begin
+      rows.each do |row|
+        batch << row
+        next if batch.size < batch_size
+        cursor ||= bulk_insert_cursor(table_or_sql, row.size)
+        bulk_insert_batch(cursor, batch, batch_size, offset, types, bind_types, errors) do |*args|
+          yield(*args) if block_given?
+        end
+        offset += batch.size
+        batch = []
+      end
+      if batch.size > 0
+        cursor ||= bulk_insert_cursor(table_or_sql, batch[0].size)
+        bulk_insert_batch(cursor, batch, batch_size, offset, types, bind_types, errors) do |*args|
+          yield(*args) if block_given?
+        end
+      end
+    ensure
+      cursor.close if cursor
+    end
+    errors
+  end
+
   def username
     @username || begin
       exec('select user from dual') do |row|
@@ -338,6 +468,27 @@ class OCI8
     "#<OCI8:#{username}>"
   end
 
+  # Returns the number of cursors kept by the client-side cursor cache
+  # set by {OCI8.properties}[:cursor_cache_size].
+  #
+  # @return [Integer]
+  # @since 2.2.15
+  def cursor_cache_count
+    @cursor_cache.size
+  end
+
+  # Closes all cursors kept by the client-side cursor cache.
+  #
+  # @since 2.2.15
+  def clear_cursor_cache
+    cache = @cursor_cache
+    @cursor_cache = {}
+    cache.each_value do |cursor|
+      cursor.send(:close_internal)
+    end
+    self
+  end
+
   # Returns the Oracle server version.
   #
   # When the Oracle client version is 12c or earlier and
@@ -505,6 +656,100 @@ class OCI8
 
   private
 
+  # @private
+  def bulk_insert_cursor(table_or_sql, num_cols)
+    if table_or_sql =~ /\A\s*INSERT\s/i
+      sql = table_or_sql
+    else
+      sql = "INSERT INTO #{table_or_sql} VALUES (#{(1..num_cols).collect { |i| ":#{i}" }.join(', ')})"
+    end
+    parse_internal(sql)
+  end
+
+  # Inserts a batch of rows. Bind variables are bound again only when
+  # a bind type is changed or strings longer than the bind length are
+  # found.
+  #
+  # @private
+  def bulk_insert_batch(cursor, batch, batch_size, offset, types, bind_types, errors)
+    columns = batch.transpose
+    new_types = columns.each_with_index.collect do |column, i|
+      type, length, unknown = bind_types[i]
+      if type.nil? || unknown
+        # The type is guessed again while all values are nil.
+        val = column.find { |v| !v.nil? }
+        unknown = types[i].nil? && val.nil?
+        new_type = types[i] || (val ? val.class : String)
+        length = nil if new_type != type
+        type = new_type
+      end
+      if type == String
+        column.each do |val|
+          next if val.nil?
+          len = val.to_s.bytesize
+          length = len if length.nil? || len > length
+        end
+        length ||= 1
+      end
+      [type, length, unknown]
+    end
+    if new_types != bind_types
+      cursor.max_array_size = batch_size
+      new_types.each_with_index do |(type, length), i|
+        cursor.bind_param_array(i + 1, nil, type, length)
+      end
+      bind_types.replace(new_types)
+    end
+    cursor.exec_columns(columns, false, true)
+    cursor.batch_errors.each do |idx, err|
+      errors << [offset + idx, err]
+      yield(offset + idx, err, batch[idx])
+    end
+  end
+
+  # Keeps the statement handle of a closed cursor in the cursor
+  # cache. The least recently used one is closed when the cache is full.
+  # This returns false when the cursor isn't cached.
+  #
+  # @private
+  def cache_cursor(cursor, sql)
+    return false if sql.nil? or @cursor_cache_size <= 0
+    return false if @cursor_cache.has_key?(sql) # another cursor with same SQL text is cached.
+    # Keep a new cursor not referred by the caller.
+    cached = cursor.send(:detach)
+    return false if cached.nil?
+    @cursor_cache[sql] = cached
+    if @cursor_cache.size > @cursor_cache_size
+      @cursor_cache.shift[1].send(:close_internal)
+    end
+    true
+  end
+
+  # Initializes instance variables of a connected session.
+  #
+  # @private
+  def init_session_vars
+    @prefetch_rows = 100
+    @username = nil
+    @cursor_cache_size = OCI8.properties[:cursor_cache_size]
+    @cursor_cache = {} # SQL text => closed cursor, least recently used first.
+  end
+
+  # Gets a session from +spool+ by OCISessionGet().
+  #
+  # @private
+  def get_session_from_pool(username, password, spool, tag)
+    if tag.is_a? Symbol
+      raise ArgumentError, "Session pooling doesn't support #{tag} privilege."
+    end
+    mode = 0x0001 # OCI_SESSGET_SPOOL
+    mode |= 0x0004 # OCI_SESSGET_STMTCACHE
+    mode |= 0x0020 if spool.tag_match_any? # OCI_SESSGET_SPOOL_MATCHANY
+    @session_tag, @session_tag_found =
+      session_get(spool.send(:pool_name), username, password, tag,
+                  spool.connection_class, spool.send(:purity_value), mode)
+  end
+
   # Converts the specified privilege name to the value passed to the
   # fifth argument of OCISessionBegin().
   #
@@ -173,6 +173,23 @@ class OCIHandle
   # @private
   OCI_ATTR_CONN_INCR          = 185
 
+  # @private
+  OCI_ATTR_SPOOL_STMTCACHESIZE = 208
+  # @private
+  OCI_ATTR_SPOOL_TIMEOUT      = 308
+  # @private
+  OCI_ATTR_SPOOL_GETMODE      = 309
+  # @private
+  OCI_ATTR_SPOOL_BUSY_COUNT   = 310
+  # @private
+  OCI_ATTR_SPOOL_OPEN_COUNT   = 311
+  # @private
+  OCI_ATTR_SPOOL_MIN          = 312
+  # @private
+  OCI_ATTR_SPOOL_MAX          = 313
+  # @private
+  OCI_ATTR_SPOOL_INCR         = 314
+
   # is this position overloaded
   # @private
   OCI_ATTR_OVERLOAD           = 210
@@ -0,0 +1,288 @@
+#--
+# pool.rb -- OCI8::Pool
+#
+# Copyright (C) 2024 Kubo Takehiro <kubo@jiubao.org>
+#++
+
+require 'thread'
+
+#
+class OCI8
+
+  # A thread-safe pool of {OCI8} connections.
+  #
+  # An {OCI8} object cannot be used by more than one thread at a time.
+  # Multi-threaded applications check out a connection, use it in a
+  # thread and check it in.
+  #
+  # Unlike {OCI8::ConnectionPool} and {OCI8::SessionPool}, this pools
+  # {OCI8} objects in ruby. Connections are created by the arguments
+  # passed to {#initialize} or by the block, so they may be sessions
+  # got from an {OCI8::SessionPool}.
+  #
+  # When no connection is idle and the number of connections reaches
+  # +max_size+, {#checkout} waits until another thread checks in a
+  # connection. A connection idle for more than +:ping_interval+
+  # seconds is checked by {OCI8#ping} before it is returned.
+  #
+  # @example
+  #   pool = OCI8::Pool.new(25, username, password, database)
+  #   pool.with_connection do |conn|
+  #     conn.exec('...')
+  #   end
+  #
+  # @since 2.2.15
+  class Pool
+
+    # Raised when no connection is available within the timeout.
+    class TimeoutError < RuntimeError
+    end
+
+    # Default options.
+    #
+    # +:timeout+:: seconds to wait for a connection in {#checkout}
+    # +:ping_interval+:: connections idle for more than this seconds
+    #                    are checked by {OCI8#ping} at checkout.
+    #                    +nil+ disables the check.
+    # +:max_waiters+:: the maximum number of threads waiting for a
+    #                  connection. +nil+ means no limit.
+    DEFAULT_OPTIONS = {
+      :timeout => 5,
+      :ping_interval => 60,
+      :max_waiters => nil,
+    }
+
+    # Returns the maximum number of connections.
+    #
+    # @return [Integer]
+    attr_reader :max_size
+
+    # @overload initialize(max_size, username, password, dbname = nil, options = {})
+    #   Creates a pool of connections created by
+    #   <code>OCI8.new(username, password, dbname)</code>.
+    #
+    # @overload initialize(max_size, options = {}) { ... }
+    #   Creates a pool of connections created by the block.
+    #
+    # @param [Integer] max_size the maximum number of connections
+    # @param [Hash] options see {DEFAULT_OPTIONS}
+    def initialize(max_size, *args, &block)
+      @max_size = max_size.to_i
+      raise ArgumentError, "max_size must be positive" if @max_size <= 0
+      options = args.last.is_a?(Hash) ? args.pop : {}
+      if block
+        raise ArgumentError, "both connect arguments and a block are given" unless args.empty?
+        @connect = block
+      else
+        raise ArgumentError, "wrong number of arguments" if args.size < 2 || args.size > 3
+        @connect = lambda { OCI8.new(*args) }
+      end
+      options = DEFAULT_OPTIONS.merge(options)
+      @timeout = options[:timeout]
+      @ping_interval = options[:ping_interval]
+      @max_waiters = options[:max_waiters]
+      @mutex = Mutex.new
+      @cond = ConditionVariable.new
+      @idle = [] # [connection, last used time], most recently used last
+      @busy = {} # checked-out connections
+      @size = 0 # the number of connections including ones being created
+      @num_waiters = 0
+      @closed = false
+    end
+
+    # Returns the number of connections.
+    #
+    # @return [Integer]
+    def size
+      @mutex.synchronize { @size }
+    end
+
+    # Returns the number of idle connections.
+    #
+    # @return [Integer]
+    def idle_count
+      @mutex.synchronize { @idle.size }
+    end
+
+    # Returns the number of checked-out connections.
+    #
+    # @return [Integer]
+    def busy_count
+      @mutex.synchronize { @size - @idle.size }
+    end
+
+    # Checks out a connection.
+    #
+    # It returns an idle connection if exists. Otherwise it creates a
+    # new connection when the number of connections is less than
+    # +max_size+, or waits until another thread checks in a
+    # connection.
+    #
+    # @param [Numeric] timeout seconds to wait. The +:timeout+ option
+    #   is used when it is +nil+.
+    # @return [OCI8]
+    # @raise [OCI8::Pool::TimeoutError] when no connection is available within the timeout.
+    def checkout(timeout = nil)
+      loop do
+        conn, last_used = reserve(timeout || @timeout)
+        if conn.nil?
+          conn = create_connection
+        elsif @ping_interval && now - last_used > @ping_interval && !alive?(conn)
+          discard_connection(conn)
+          next
+        end
+        @mutex.synchronize { @busy[conn] = true }
+        return conn
+      end
+    end
+
+    # Checks in a connection checked out by {#checkout}.
+    #
+    # @param [OCI8] conn
+    # @param [Boolean] discard +true+ to log off +conn+ instead of
+    #   reusing it, e.g. when it is disconnected.
+    # @raise [ArgumentError] when +conn+ isn't checked out from the
+    #   pool or is already checked in.
+    def checkin(conn, discard = false)
+      discard = @mutex.synchronize do
+        unless @busy.delete(conn)
+          raise ArgumentError, "the connection is not checked out from this pool"
+        end
+        unless discard || @closed
+          @idle << [conn, now]
+          @cond.signal
+        end
+        discard || @closed
+      end
+      discard_connection(conn) if discard
+      nil
+    end
+
+    # Checks out a connection, yields it and checks it in.
+    # When a disconnection error is raised, the connection is
+    # discarded.
+    #
+    # @yieldparam [OCI8] conn
+    # @return the value of the block
+    def with_connection
+      conn = checkout
+      discard = false
+      begin
+        yield conn
+      rescue OCIError
+        discard = true if disconnected_error?($!)
+        raise
+      ensure
+        checkin(conn, discard)
+      end
+    end
+
+    # Logs off all idle connections. Checked-out connections are
+    # logged off when they are checked in.
+    def close
+      idle = @mutex.synchronize do
+        @closed = true
+        @cond.broadcast
+        conns = @idle.map { |conn, last_used| conn }
+        @idle.clear
+        conns
+      end
+      idle.each { |conn| discard_connection(conn) }
+      nil
+    end
+
+    # Returns +true+ when the pool is closed.
+    def closed?
+      @closed
+    end
+
+    private
+
+    if defined? Process::CLOCK_MONOTONIC
+      def now
+        Process.clock_gettime(Process::CLOCK_MONOTONIC)
+      end
+    else
+      def now
+        Time.now.to_f
+      end
+    end
+
+    # Takes an idle connection or reserves a slot to create a new one.
+    # This returns +nil+ in the latter case.
+    def reserve(timeout)
+      @mutex.synchronize do
+        raise RuntimeError, "The pool is closed." if @closed
+        # fast path
+        return @idle.pop unless @idle.empty?
+        if @size < @max_size
+          @size += 1
+          return nil
+        end
+        # slow path
+        if @max_waiters && @num_waiters >= @max_waiters
+          raise TimeoutError, "too many threads are waiting for a connection"
+        end
+        deadline = now + timeout
+        @num_waiters += 1
+        begin
+          loop do
+            rest = deadline - now
+            if rest <= 0
+              raise TimeoutError, "could not get a connection within #{timeout} seconds"
+            end
+            @cond.wait(@mutex, rest)
+            raise RuntimeError, "The pool is closed." if @closed
+            return @idle.pop unless @idle.empty?
+            if @size < @max_size
+              @size += 1
+              return nil
+            end
+          end
+        ensure
+          @num_waiters -= 1
+        end
+      end
+    end
+
+    def create_connection
+      @connect.call
+    rescue Exception
+      release_slot
+      raise
+    end
+
+    def release_slot
+      @mutex.synchronize do
+        @size -= 1
+        @cond.signal
+      end
+    end
+
+    def discard_connection(conn)
+      release_slot
+      begin
+        conn.logoff
+      rescue OCIException
+      end
+    end
+
+    def alive?(conn)
+      conn.ping
+    rescue OCIException
+      false
+    end
+
+    # ORA-00028: your session has been killed
+    # ORA-01012: not logged on
+    # ORA-03113: end-of-file on communication channel
+    # ORA-03114: not connected to ORACLE
+    # ORA-03135: connection lost contact
+    # ORA-12537: TNS:connection closed
+    DISCONNECTED_ERROR_CODES = [28, 1012, 3113, 3114, 3135, 12537]
+
+    def disconnected_error?(error)
+      DISCONNECTED_ERROR_CODES.include?(error.code)
+    end
+  end
+end
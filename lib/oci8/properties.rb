@@ -19,6 +19,8 @@ class OCI8
     :recv_timeout => nil,
     :tcp_keepalive => false,
     :tcp_keepalive_time => nil,
+    :fetch_buffer_size => nil,
+    :cursor_cache_size => 0,
   }
 
   # @private
@@ -72,7 +74,17 @@ class OCI8
         raise ArgumentError, "The property value for :#{name} must be nil or a positive integer." if val <= 0
       end
       OCI8.__set_prop(4, val)
+    when :fetch_buffer_size
+      if !val.nil?
+        val = val.to_i
+        raise ArgumentError, "The property value for :#{name} must be nil or a positive integer." if val <= 0
+      end
+    when :cursor_cache_size
+      val = val.to_i
+      raise ArgumentError, "The property value for :cursor_cache_size must not be negative." if val < 0
     end
+    # cached define plans depend on the length semantics.
+    OCI8::BindType::DefinePlans.clear if name == :length_semantics
     super(name, val)
   end
 
@@ -187,6 +199,28 @@ class OCI8
   #
   #     *Since:* 2.2.4
   #
+  # [:fetch_buffer_size]
+  #
+  #     The default value of {OCI8::Cursor#fetch_buffer_size=}, which is the
+  #     memory budget in bytes to fetch rows by array fetching.
+  #     The default value is +nil+, which turns off the adaptive array fetching.
+  #
+  #     *Since:* 2.2.15
+  #
+  # [:cursor_cache_size]
+  #
+  #     The number of closed cursors kept per each connection to be reused
+  #     by {OCI8#parse} and {OCI8#exec} with the same SQL text. Reused
+  #     cursors skip preparing the statement and describing and defining
+  #     select-list columns. The default size is 0, which means no cursor
+  #     cache. This is applied to connections established after it is set.
+  #
+  #     Note that a cursor must not be used after it is closed when this is
+  #     positive and that changes of select-list columns by DDL statements
+  #     after the first execution are not detected.
+  #
+  #     *Since:* 2.2.15
+  #
   # @return [a customized Hash]
   # @since 2.0.5
   #
@@ -0,0 +1,201 @@
+#--
+# session_pool.rb -- OCI8::SessionPool
+#
+# Copyright (C) 2024 Kubo Takehiro <kubo@jiubao.org>
+#++
+
+#
+class OCI8
+
+  # Session pooling caches logical sessions in a pool.
+  # See: {Oracle Call Interface Manual}[https://docs.oracle.com/en/database/oracle/oracle-database/19/lnoci/session-and-connection-pooling.html]
+  #
+  # Unlike {OCI8::ConnectionPool}, which caches physical connections,
+  # this caches sessions themselves. When an application creates an
+  # {OCI8} from the pool, an idle session is got from the pool without
+  # a login round trip. It returns to the pool by {OCI8#logoff}.
+  #
+  # Each session in the pool has its own statement cache, which keeps
+  # prepared statements across checkouts.
+  #
+  # Example:
+  #   # Create a homogeneous session pool.
+  #   # The number of initial sessions: 2
+  #   # The number of maximum sessions: 10
+  #   # The session increment parameter: 2
+  #   spool = OCI8::SessionPool.new(2, 10, 2, username, password, database)
+  #
+  #   # Get a session from the pool.
+  #   conn = OCI8.new(nil, nil, spool)
+  #   conn.exec('...')
+  #   # Return the session to the pool.
+  #   conn.logoff
+  #
+  # === session tagging
+  #
+  # A session can be tagged by {OCI8#session_tag=} to indicate its
+  # state, such as NLS parameters. The tag is requested by the fourth
+  # argument of {OCI8#initialize}.
+  #
+  #   conn = OCI8.new(nil, nil, spool, 'NLS_DATE_FORMAT=YYYY-MM-DD')
+  #   unless conn.session_tag_found?
+  #     conn.exec("ALTER SESSION SET NLS_DATE_FORMAT = 'YYYY-MM-DD'")
+  #     conn.session_tag = 'NLS_DATE_FORMAT=YYYY-MM-DD'
+  #   end
+  #
+  # === Database Resident Connection Pooling (DRCP)
+  #
+  # Use a connect string with <code>(SERVER=POOLED)</code> or
+  # <code>:POOLED</code> and set {#connection_class=}.
+  #
+  #   spool = OCI8::SessionPool.new(2, 10, 2, username, password, '//host/service:POOLED')
+  #   spool.connection_class = 'MYAPP'
+  #
+  # @since 2.2.15
+  class SessionPool
+
+    # The connection class of Database Resident Connection Pooling.
+    # Sessions in a DRCP server pool are shared among clients with the
+    # same connection class.
+    #
+    # @return [String]
+    attr_accessor :connection_class
+
+    # Sessions idle for more than this time value (in seconds) are
+    # terminated. If it is zero, the sessions are never timed out.
+    # The default value is zero.
+    #
+    # @return [Integer]
+    def timeout
+      attr_get_ub4(OCI_ATTR_SPOOL_TIMEOUT)
+    end
+
+    # Changes the timeout in seconds to terminate idle sessions.
+    #
+    # @param [Integer] val
+    def timeout=(val)
+      attr_set_ub4(OCI_ATTR_SPOOL_TIMEOUT, val)
+    end
+
+    # If true, an error is raised when all the sessions in the pool
+    # are busy and the number of sessions has already reached the
+    # maximum. Otherwise the call waits till it gets a session.
+    # The default value is false.
+    def nowait?
+      attr_get_ub1(OCI_ATTR_SPOOL_GETMODE) == 1 # OCI_SPOOL_ATTRVAL_NOWAIT
+    end
+
+    # Changes the behavior when all the sessions in the pool are busy
+    # and the number of sessions has already reached the maximum.
+    #
+    # @param [Boolean] val
+    def nowait=(val)
+      # OCI_SPOOL_ATTRVAL_NOWAIT or OCI_SPOOL_ATTRVAL_WAIT
+      attr_set_ub1(OCI_ATTR_SPOOL_GETMODE, val ? 1 : 0)
+    end
+
+    # Returns the number of busy sessions.
+    #
+    # @return [Integer]
+    def busy_count
+      attr_get_ub4(OCI_ATTR_SPOOL_BUSY_COUNT)
+    end
+
+    # Returns the number of open sessions.
+    #
+    # @return [Integer]
+    def open_count
+      attr_get_ub4(OCI_ATTR_SPOOL_OPEN_COUNT)
+    end
+
+    # Returns the number of minimum sessions.
+    #
+    # @return [Integer]
+    def min
+      attr_get_ub4(OCI_ATTR_SPOOL_MIN)
+    end
+
+    # Returns the number of maximum sessions.
+    #
+    # @return [Integer]
+    def max
+      attr_get_ub4(OCI_ATTR_SPOOL_MAX)
+    end
+
+    # Returns the session increment parameter.
+    #
+    # @return [Integer]
+    def incr
+      attr_get_ub4(OCI_ATTR_SPOOL_INCR)
+    end
+
+    # Returns the size of the statement cache of each session.
+    #
+    # @return [Integer]
+    def statement_cache_size
+      attr_get_ub4(OCI_ATTR_SPOOL_STMTCACHESIZE)
+    end
+
+    # Changes the size of the statement cache of each session.
+    #
+    # @param [Integer] val
+    def statement_cache_size=(val)
+      attr_set_ub4(OCI_ATTR_SPOOL_STMTCACHESIZE, val)
+    end
+
+    # If true, a session with a different tag may be returned when
+    # no session with the requested tag is available.
+    # Check {OCI8#session_tag} in the case.
+    # The default value is false.
+    def tag_match_any?
+      @tag_match_any ? true : false
+    end
+
+    # Changes whether a session with a different tag may be returned.
+    #
+    # @param [Boolean] val
+    def tag_match_any=(val)
+      @tag_match_any = val
+    end
+
+    # Returns the purity of sessions got from a DRCP server pool.
+    #
+    # @return [Symbol] :default, :new or :self
+    def purity
+      @purity || :default
+    end
+
+    # Changes the purity of sessions got from a DRCP server pool.
+    # +:new+ requires a new session not used by others.
+    # +:self+ allows a session used by the same connection class.
+    #
+    # @param [Symbol] val :default, :new or :self
+    def purity=(val)
+      case val
+      when :default, :new, :self
+        @purity = val
+      else
+        raise ArgumentError, "invalid purity: #{val.inspect}"
+      end
+    end
+
+    #
+    def destroy
+      free
+    end
+
+    private
+
+    # Returns the value of OCI_ATTR_PURITY.
+    def purity_value
+      case @purity
+      when :new
+        1 # OCI_ATTR_PURITY_NEW
+      when :self
+        2 # OCI_ATTR_PURITY_SELF
+      else
+        0 # OCI_ATTR_PURITY_DEFAULT
+      end
+    end
+  end
+end
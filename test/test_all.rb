@@ -25,6 +25,8 @@ require "#{srcdir}/test_appinfo"
 require "#{srcdir}/test_oracle_version"
 require "#{srcdir}/test_error"
 require "#{srcdir}/test_connection_pool"
+require "#{srcdir}/test_session_pool"
+require "#{srcdir}/test_pool"
 require "#{srcdir}/test_object"
 require "#{srcdir}/test_properties.rb"
 
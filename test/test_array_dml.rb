@@ -329,4 +329,89 @@ EOS
     cursor.close
     drop_table('test_table')
   end
+
+  # insert with columns of values
+  def test_exec_columns
+    drop_table('test_table')
+    sql = <<-EOS
+CREATE TABLE test_table
+  (N NUMBER(10),
+   F NUMBER(10, 2),
+   V VARCHAR2(20))
+EOS
+    @conn.exec(sql)
+    cursor = @conn.parse("INSERT INTO test_table VALUES (:N, :F, :V)")
+    cursor.max_array_size = 4
+    # columns are ordered by position, not by the order of binding.
+    cursor.bind_param_array(3, nil, String, 20)
+    cursor.bind_param_array(1, nil, Integer)
+    cursor.bind_param_array(2, nil, Float)
+    assert_equal(3, cursor.exec_columns([[1, 2, 3], [0.5, nil, 1.5], ['a', 'b', nil]]))
+    nulls = ['0100'].pack('b*') # the second value is NULL.
+    assert_equal(4, cursor.exec_columns([[[4, 5, 6, 7].pack('q*'), nil],
+                                         [[2.5, 0.0, 3.5, 4.5].pack('d*'), nulls],
+                                         ['d', 'e', 'f', 'g']], true))
+    assert_raises(RuntimeError) do
+      cursor.exec_columns([[8, 9], [1.0], ['h', 'i']])
+    end
+    cursor.close
+
+    cursor = @conn.parse("INSERT INTO test_table VALUES (:N, :F, :V)")
+    cursor.max_array_size = 4
+    cursor.bind_param_array(:N, nil, Integer)
+    cursor.bind_param_array(:F, nil, Float)
+    cursor.bind_param_array(:V, nil, String, 20)
+    assert_raises(ArgumentError) do
+      cursor.exec_columns([[8], [1.0], ['h']])
+    end
+    cursor.close
+
+    cursor = @conn.exec("SELECT * FROM test_table ORDER BY N")
+    assert_equal([1, 0.5, 'a'], cursor.fetch)
+    assert_equal([2, nil, 'b'], cursor.fetch)
+    assert_equal([3, 1.5, nil], cursor.fetch)
+    assert_equal([4, 2.5, 'd'], cursor.fetch)
+    assert_equal([5, nil, 'e'], cursor.fetch)
+    assert_equal([6, 3.5, 'f'], cursor.fetch)
+    assert_equal([7, 4.5, 'g'], cursor.fetch)
+    assert_nil(cursor.fetch)
+    cursor.close
+    drop_table('test_table')
+  end
+
+  # bulk insert with batch errors
+  def test_bulk_insert
+    drop_table('test_table')
+    @conn.exec("CREATE TABLE test_table (N NUMBER(10) PRIMARY KEY, V VARCHAR2(20) NOT NULL)")
+    rows = [[1, 'a'], [2, 'b'], [1, 'c'], [3, 'd'], [4, 'e'], [5, nil], [6, 'long string ' * 2]]
+    failed = []
+    errors = @conn.bulk_insert('test_table', rows, :batch_size => 3) do |index, err, row|
+      failed << [index, err.code, row]
+    end
+    assert_equal([2, 5, 6], errors.collect { |index, err| index })
+    assert_equal([[2, 1, [1, 'c']], [5, 1400, [5, nil]]], failed[0, 2])
+    assert_equal(3, failed.size)
+    assert_equal(6, failed[2][0])
+    assert_equal(12899, failed[2][1])
+    assert_equal(4, @conn.select_one('SELECT COUNT(*) FROM test_table')[0])
+    drop_table('test_table')
+  end
+
+  # bulk insert where a column is nil in the first batch
+  def test_bulk_insert_with_nil_column
+    drop_table('test_table')
+    @conn.exec("CREATE TABLE test_table (N NUMBER(10) PRIMARY KEY, I NUMBER(10), D DATE)")
+    t = Time.local(2024, 1, 2, 3, 4, 5)
+    rows = [[1, nil, nil], [2, nil, nil], [3, 30, t], [4, nil, t]]
+    errors = @conn.bulk_insert('test_table', rows, :batch_size => 2)
+    assert_equal([], errors)
+    cursor = @conn.exec('SELECT * FROM test_table ORDER BY N')
+    assert_equal([1, nil, nil], cursor.fetch)
+    assert_equal([2, nil, nil], cursor.fetch)
+    assert_equal([3, 30, t], cursor.fetch)
+    assert_equal([4, nil, t], cursor.fetch)
+    assert_nil(cursor.fetch)
+    cursor.close
+    drop_table('test_table')
+  end
 end
@@ -1,5 +1,6 @@
 # Low-level API
 require 'oci8'
+require 'stringio'
 require File.dirname(__FILE__) + '/config'
 
 class TestCLob < Minitest::Test
@@ -58,6 +59,154 @@ class TestCLob < Minitest::Test
     lob.close
   end
 
+  def test_read_into_and_each_chunk
+    data = (0...5000).collect { |i| (i % 26 + 65).chr }.join
+    lob = OCI8::CLOB.new(@conn, data)
+
+    lob.rewind
+    buf = ''
+    assert_same(buf, lob.read(1000, buf))
+    assert_equal(data[0, 1000], buf)
+    assert_equal(4000, lob.read_into(buf))
+    assert_equal(data[1000..-1], buf)
+    assert_nil(lob.read(1000, buf))
+
+    lob.rewind
+    io = StringIO.new
+    assert_equal(3000, lob.read_into(io, 3000))
+    assert_equal(data[0, 3000], io.string)
+
+    lob.rewind
+    chunks = []
+    lob.each_chunk(1024) do |chunk|
+      chunks << chunk.dup
+    end
+    assert_equal([1024, 1024, 1024, 1024, 904], chunks.collect(&:size))
+    assert_equal(data, chunks.join)
+    lob.close
+  end
+
+  def test_write_from
+    data = (0...5000).collect { |i| (i % 26 + 65).chr }.join
+    lob = OCI8::CLOB.new(@conn, '')
+    assert_equal(5000, lob.write_from(StringIO.new(data), 1024))
+    assert_equal(5000, lob.pos)
+    lob.rewind
+    assert_equal(data, lob.read)
+
+    lob.rewind
+    lob.truncate(0)
+    assert_equal(5000, lob.write_from(data.scan(/.{1,700}/m).each))
+    lob.rewind
+    assert_equal(data, lob.read)
+    lob.close
+  end
+
+  def test_lob_prefetch_size
+    return if OCI8.oracle_client_version < OCI8::ORAVER_11_1
+    @conn.exec("INSERT INTO test_table(filename, content) VALUES ('short', 'abc')")
+    @conn.exec("INSERT INTO test_table(filename, content) VALUES ('long', :1)", 'x' * 3000)
+    cursor = @conn.parse("SELECT content FROM test_table ORDER BY filename DESC")
+    cursor.lob_prefetch_size = 1000
+    assert_equal(1000, cursor.lob_prefetch_size)
+    cursor.exec
+    assert_equal('abc', cursor.fetch[0])
+    lob = cursor.fetch[0]
+    assert_kind_of(OCI8::CLOB, lob)
+    assert_equal('x' * 3000, lob.read)
+    cursor.close
+  end
+
+  def test_lob_as_string
+    data = 'x' * 100000
+    @conn.exec("INSERT INTO test_table(filename, content) VALUES ('a', 'abc')")
+    @conn.exec("INSERT INTO test_table(filename, content) VALUES ('b', :1)", OCI8::CLOB.new(@conn, data))
+    @conn.exec("INSERT INTO test_table(filename, content) VALUES ('c', NULL)")
+    cursor = @conn.parse("SELECT content FROM test_table ORDER BY filename")
+    cursor.lob_as_string = true
+    assert(cursor.lob_as_string?)
+    cursor.exec
+    assert_equal(['abc'], cursor.fetch)
+    assert_equal([data], cursor.fetch)
+    assert_equal([nil], cursor.fetch)
+    assert_nil(cursor.fetch)
+
+    cursor.lob_as_string = false
+    cursor.exec
+    assert_kind_of(OCI8::CLOB, cursor.fetch[0])
+
+    cursor.lob_as_string = 1000
+    assert(cursor.lob_as_string?)
+    cursor.exec
+    assert_equal(['abc'], cursor.fetch)
+    assert_raises(RuntimeError) do
+      cursor.fetch
+    end
+    cursor.close
+  end
+
+  def test_read_all
+    data = 'x' * 100000
+    lobs = [OCI8::CLOB.new(@conn, 'abc'), nil, OCI8::CLOB.new(@conn, data), OCI8::CLOB.new(@conn, '')]
+    assert_equal(['abc', nil, data, ''], OCI8::LOB.read_all(lobs, 4096))
+    assert_equal(3, lobs[0].pos)
+    assert_equal(100000, lobs[2].pos)
+    # at EOF
+    assert_equal(['', nil, '', ''], OCI8::LOB.read_all(lobs))
+    lobs.each { |lob| lob.close if lob }
+  end
+
+  def test_reuse_lobs
+    @conn.exec("INSERT INTO test_table(filename, content) VALUES ('a', 'abc')")
+    @conn.exec("INSERT INTO test_table(filename, content) VALUES ('b', 'def')")
+    @conn.exec("INSERT INTO test_table(filename, content) VALUES ('c', 'ghi')")
+    cursor = @conn.parse("SELECT content FROM test_table ORDER BY filename")
+    cursor.reuse_lobs = true
+    assert(cursor.reuse_lobs?)
+    # fetch one row per fetch call to reuse the LOB object across fetches.
+    cursor.prefetch_rows = 1
+    cursor.exec
+    lob1 = cursor.fetch[0]
+    assert_equal('abc', lob1.read)
+    kept = lob1.dup
+    lob2 = cursor.fetch[0]
+    assert_same(lob1, lob2)
+    assert_equal(0, lob2.pos)
+    assert_equal('def', lob2.read)
+    # a closed LOB is replaced with a new one.
+    lob2.close
+    lob3 = cursor.fetch[0]
+    refute_same(lob2, lob3)
+    assert_equal('ghi', lob3.read)
+    assert_nil(cursor.fetch)
+    kept.rewind
+    assert_equal('abc', kept.read)
+    cursor.close
+  end
+
+  def test_to_io
+    lines = (1..1000).collect { |i| "line #{i}\n" }
+    lob = OCI8::CLOB.new(@conn, lines.join)
+    lob.rewind
+    io = lob.to_io(100)
+    assert_equal(lines[0], io.gets)
+    assert_equal(1, io.lineno)
+    assert_equal(lines[0].size, io.pos)
+    assert_equal(lines[1][0, 3], io.read(3))
+    assert_equal(lines[1][3..-1], io.readpartial(lines[1].size - 3))
+    assert_equal(lines[2..-1], io.each_line.to_a)
+    assert(io.eof?)
+    assert_nil(io.gets)
+    assert_nil(io.read(1))
+
+    io.seek(lines[0].size)
+    assert_equal(lines[1], io.gets)
+    io.rewind
+    assert_equal(lines.join, io.read)
+    io.close
+    assert(io.closed?)
+  end
+
   # https://github.com/kubo/ruby-oci8/issues/20
   def test_github_issue_20
     # Skip this test if FULLTEST isn't set because it takes 4 minutes in my Linux box.
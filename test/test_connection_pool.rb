@@ -121,4 +121,36 @@ class TestConnectionPool < Minitest::Test
 
   def test_nowait
   end
+
+  def test_parallel_lob_read
+    @conn = get_oci8_connection
+    drop_table('test_table')
+    @conn.exec('CREATE TABLE test_table (id NUMBER, blob_column BLOB)')
+    data = (0...(100 * 1024)).map { |i| (i % 251).chr }.join.force_encoding('ASCII-8BIT')
+    @conn.exec('INSERT INTO test_table VALUES (1, :1)', OCI8::BLOB.new(@conn, data))
+    @conn.commit
+
+    pool = create_pool(1, 5, 1)
+    read_blob = lambda do |conn|
+      conn.select_one('SELECT blob_column FROM test_table WHERE id = 1')[0]
+    end
+    [[1, 1024], [3, 7 * 1024], [5, 1024 * 1024]].each do |threads, piece_size|
+      msg = "threads=#{threads}, piece_size=#{piece_size}"
+      result = pool.parallel_lob_read($dbuser, $dbpass, :threads => threads, :piece_size => piece_size, &read_blob)
+      assert_equal(data, result, msg)
+    end
+
+    require 'tempfile'
+    Tempfile.open('oci8') do |f|
+      f.binmode
+      assert_equal(data.bytesize, pool.parallel_lob_read($dbuser, $dbpass, :io => f, :piece_size => 4096, &read_blob))
+      f.rewind
+      assert_equal(data, f.read)
+    end
+  ensure
+    if @conn
+      drop_table('test_table')
+      @conn.logoff
+    end
+  end
 end
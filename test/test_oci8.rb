@@ -163,6 +163,44 @@ EOS
     end
   end
 
+  def test_long_chunk_pool
+    base = OCI8::BindType::Base
+    pool_size = base.chunk_pool_size
+    initial_chunk_size = base.initial_chunk_size
+    begin
+      base.initial_chunk_size = 5
+      base.chunk_pool_size = 0 # empty the pool
+      assert_equal(0, base.chunk_pool_bytes)
+      base.chunk_pool_size = 1024 * 1024
+      assert_equal(1024 * 1024, base.chunk_pool_size)
+      pooled_bytes = nil
+      3.times do
+        cursor = @conn.parse("begin :1 := '<' || :2 || '>'; end;")
+        cursor.bind_param(1, nil, :long)
+        cursor.bind_param(2, nil, :long)
+        (LONG_TEST_DATA + ['z' * 4000]).each do |data|
+          cursor[2] = data
+          cursor.exec
+          assert_equal("<#{data}>", cursor[1])
+        end
+        cursor.close
+        # chunks are pooled when the cursor is closed.
+        assert_operator(base.chunk_pool_bytes, :>, 0)
+        if pooled_bytes
+          # chunks released by the previous cursor are reused.
+          # The pool doesn't grow.
+          assert_operator(base.chunk_pool_bytes, :<=, pooled_bytes)
+        end
+        pooled_bytes = base.chunk_pool_bytes
+      end
+      base.chunk_pool_size = 0
+      assert_equal(0, base.chunk_pool_bytes)
+    ensure
+      base.initial_chunk_size = initial_chunk_size
+      base.chunk_pool_size = pool_size
+    end
+  end
+
   def test_select
     drop_table('test_table')
     sql = <<-EOS
@@ -621,4 +659,315 @@ EOS
       assert_nil(cursor.fetch)
     end
   end
+
+  class UpcaseString < OCI8::BindType::String
+    def get
+      (val = super()) && val.upcase
+    end
+  end
+
+  def test_fetch_with_get_overridden_in_ruby
+    OCI8::BindType::Mapping[:test_upcase_string] = UpcaseString
+    cursor = @conn.parse("SELECT 'abc', 'def', CAST(NULL AS VARCHAR2(10)) FROM DUAL")
+    cursor.define(1, :test_upcase_string, 10)
+    cursor.define(3, :test_upcase_string, 10)
+    cursor.exec
+    assert_equal(['ABC', 'def', nil], cursor.fetch)
+    assert_nil(cursor.fetch)
+    cursor.exec
+    assert_equal(['ABC', 'def', nil], cursor.fetch_hash.values)
+    cursor.close
+  ensure
+    OCI8::BindType::Mapping.delete(:test_upcase_string)
+  end
+
+  def test_fetch_columns
+    cursor = @conn.parse("SELECT level, TO_CHAR(level), CASE WHEN MOD(level, 3) = 0 THEN NULL ELSE level END FROM DUAL CONNECT BY level <= 10")
+    cursor.exec
+    assert_equal([[1, 2, 3, 4], ['1', '2', '3', '4'], [1, 2, nil, 4]], cursor.fetch_columns(4))
+    assert_equal([5, '5', 5], cursor.fetch)
+    assert_equal([[6, 7, 8, 9, 10], ['6', '7', '8', '9', '10'], [nil, 7, 8, nil, 10]], cursor.fetch_columns(100))
+    assert_nil(cursor.fetch_columns(100))
+    cursor.close
+  end
+
+  def test_fetch_buffer_size
+    cursor = @conn.parse("SELECT level, RPAD('x', 100, 'x') FROM DUAL CONNECT BY level <= 1000")
+    cursor.prefetch_rows = 10
+    cursor.fetch_buffer_size = 100000
+    cursor.exec
+    1.upto(1000) do |i|
+      assert_equal([i, 'x' * 100], cursor.fetch)
+    end
+    assert_nil(cursor.fetch)
+    fetch_array_size = cursor.instance_variable_get(:@fetch_array_size)
+    assert_operator(fetch_array_size, :>, 10)
+    assert_operator(fetch_array_size * cursor.send(:__define_row_size), :<=, 100000)
+    cursor.close
+  end
+
+  def test_fetch_across_prefetch_buffer
+    cursor = @conn.parse("SELECT level FROM DUAL CONNECT BY level <= :1")
+    [[1, 10], [7, 50], [100, 30], [3, 3]].each do |prefetch_rows, num_rows|
+      cursor.prefetch_rows = prefetch_rows
+      cursor.exec(num_rows)
+      1.upto(num_rows) do |i|
+        assert_equal([i], cursor.fetch, "prefetch_rows=#{prefetch_rows}")
+      end
+      assert_nil(cursor.fetch)
+    end
+    cursor.close
+  end
+
+  def test_async_mode
+    assert_equal(false, @conn.async_mode?)
+    begin
+      @conn.async_mode = true
+    rescue NotImplementedError
+      return
+    end
+    assert_equal(true, @conn.async_mode?)
+    # no effect without a fiber scheduler
+    assert_equal([1], @conn.select_one('SELECT 1 FROM DUAL'))
+    @conn.async_mode = false
+    assert_equal(false, @conn.async_mode?)
+  end
+
+  # A minimal fiber scheduler which supports only sleep.
+  class SleepScheduler
+    def initialize
+      @waiting = {} # fiber => time to resume or nil
+    end
+
+    def fiber(&block)
+      fiber = Fiber.new(:blocking => false, &block)
+      fiber.resume
+      fiber
+    end
+
+    def kernel_sleep(duration = nil)
+      @waiting[Fiber.current] = duration && now + duration
+      Fiber.yield
+    end
+
+    def block(blocker, timeout = nil)
+      kernel_sleep(timeout)
+    end
+
+    def unblock(blocker, fiber)
+      @waiting[fiber] = now
+    end
+
+    def io_wait(io, events, timeout)
+      raise NotImplementedError
+    end
+
+    def close
+      until @waiting.empty?
+        fiber, time = @waiting.select { |f, t| t }.min_by { |f, t| t }
+        raise "deadlock" if fiber.nil?
+        sleep(time - now) if time > now
+        @waiting.delete(fiber)
+        fiber.resume
+      end
+    end
+
+    private
+
+    def now
+      Process.clock_gettime(Process::CLOCK_MONOTONIC)
+    end
+  end
+
+  def test_async_mode_with_fiber_scheduler
+    return if RUBY_VERSION < '3.0'
+    begin
+      @conn.async_mode = true
+    rescue NotImplementedError
+      return
+    end
+    conn2 = get_oci8_connection
+    conn2.async_mode = true
+    if $oracle_server_version >= OCI8::ORAVER_18
+      plsql = 'BEGIN DBMS_SESSION.SLEEP(2); END;'
+    else
+      plsql = 'BEGIN DBMS_LOCK.SLEEP(2); END;'
+    end
+    results = {}
+    start_time = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+    Thread.new do
+      Fiber.set_scheduler(SleepScheduler.new)
+      Fiber.schedule do
+        @conn.exec(plsql)
+        results[:conn1] = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start_time
+      end
+      Fiber.schedule do
+        begin
+          conn2.exec(plsql)
+          results[:conn2] = :not_canceled
+        rescue OCIBreak
+          results[:conn2] = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start_time
+        end
+      end
+      Fiber.schedule do
+        sleep(0.5)
+        results[:break] = conn2.break
+      end
+      Fiber.set_scheduler(nil) # run the fibers until all of them finish.
+    end.join
+    # The two calls overlapped.
+    assert_operator(results[:conn1], :>=, 1.5)
+    assert_operator(results[:conn1], :<, 3.5)
+    # The call in conn2 was canceled by OCI8#break.
+    assert_equal(true, results[:break])
+    assert_kind_of(Float, results[:conn2])
+    assert_operator(results[:conn2], :<, 1.5)
+    # The non-blocking mode is restored and the connections are usable.
+    @conn.async_mode = false
+    conn2.async_mode = false
+    assert_equal([1], @conn.select_one('SELECT 1 FROM DUAL'))
+    assert_equal([1], conn2.select_one('SELECT 1 FROM DUAL'))
+    conn2.logoff
+  end
+
+  def test_intern_strings
+    cursor = @conn.parse("SELECT DECODE(MOD(level, 2), 0, 'even', 'odd') FROM DUAL CONNECT BY level <= 4")
+    cursor.intern_strings = true
+    cursor.exec
+    rows = []
+    while row = cursor.fetch
+      rows << row[0]
+    end
+    assert_equal(['odd', 'even', 'odd', 'even'], rows)
+    assert(rows.all? { |str| str.frozen? })
+    if RUBY_VERSION >= '3.0'
+      assert_same(rows[0], rows[2])
+      assert_same(rows[1], rows[3])
+    end
+    cursor.close
+  end
+
+  def test_fetch_packed_columns
+    cursor = @conn.parse("SELECT level, CASE WHEN MOD(level, 3) = 0 THEN NULL ELSE level / 2 END, TO_CHAR(level) FROM DUAL CONNECT BY level <= 10")
+    cursor.define(1, Integer)
+    cursor.define(2, Float)
+    cursor.exec
+    cols = cursor.fetch_columns(4, true)
+    assert_equal([1, 2, 3, 4], cols[0][0].unpack('q*'))
+    assert_equal('0000', cols[0][1].unpack('b4')[0])
+    assert_equal([0.5, 1.0, 0.0, 2.0], cols[1][0].unpack('d*'))
+    assert_equal('0010', cols[1][1].unpack('b4')[0])
+    assert_equal(['1', '2', '3', '4'], cols[2])
+    assert_equal([5, 2.5, '5'], cursor.fetch)
+    cols = cursor.fetch_columns(100, true)
+    assert_equal([6, 7, 8, 9, 10], cols[0][0].unpack('q*'))
+    assert_equal([0.0, 3.5, 4.0, 0.0, 5.0], cols[1][0].unpack('d*'))
+    assert_equal('10010', cols[1][1].unpack('b5')[0])
+    assert_nil(cursor.fetch_columns(100, true))
+    cursor.close
+  end
+
+  def test_temp_lob_free_threshold
+    assert_equal(0, @conn.temp_lob_free_threshold)
+    @conn.temp_lob_free_threshold = 100
+    assert_equal(100, @conn.temp_lob_free_threshold)
+    create_temp_clobs(10)
+    GC.start
+    # Freeing LOBs is deferred while the number of them doesn't exceed the threshold.
+    @conn.exec('select 1 from dual') { |row| }
+    pending = @conn.pending_temp_lobs
+    assert_operator(pending, :>, 0)
+    assert_equal(pending, @conn.free_temp_lobs)
+    assert_equal(0, @conn.pending_temp_lobs)
+  ensure
+    @conn.temp_lob_free_threshold = 0
+  end
+
+  # Creates temporary LOBs in a separate method to make them
+  # unreachable from the caller's stack.
+  def create_temp_clobs(num)
+    num.times { OCI8::CLOB.new(@conn, 'temp') }
+    nil
+  end
+
+  def test_cursor_cache
+    oldval = OCI8.properties[:cursor_cache_size]
+    begin
+      OCI8.properties[:cursor_cache_size] = 2
+      conn = get_oci8_connection()
+    ensure
+      OCI8.properties[:cursor_cache_size] = oldval
+    end
+    sql = 'SELECT :1 + 1 FROM DUAL'
+    cursor = conn.parse(sql)
+    cursor.exec(1)
+    assert_equal([2], cursor.fetch)
+    cursor.close
+    assert_equal(1, conn.cursor_cache_count)
+    # the closed cursor isn't reused.
+    assert_raises(OCIException) do
+      cursor.exec(1)
+    end
+    cursor2 = conn.parse(sql)
+    refute_same(cursor, cursor2)
+    assert_equal(0, conn.cursor_cache_count)
+    # bind variables aren't kept.
+    err = assert_raises(OCIError) do
+      cursor2.exec
+    end
+    assert_equal(1008, err.code)
+    cursor2.exec(5)
+    assert_equal([6], cursor2.fetch)
+    cursor2.close
+    # columns defined by OCI8::Cursor#define aren't kept.
+    cursor = conn.parse(sql)
+    cursor.define(1, String)
+    cursor.exec(1)
+    assert_equal(['2'], cursor.fetch)
+    cursor.close
+    assert_equal([3], conn.select_one(sql, 2))
+    conn.exec(sql, 3) do |row|
+      assert_equal([4], row)
+    end
+    assert_equal(1, conn.cursor_cache_count)
+    # the least recently used cursor is closed when the cache is full.
+    conn.exec('SELECT 1 FROM DUAL') {}
+    conn.exec('SELECT 2 FROM DUAL') {}
+    assert_equal(2, conn.cursor_cache_count)
+    assert(!cursor.equal?(conn.parse(sql)))
+    conn.clear_cursor_cache
+    assert_equal(0, conn.cursor_cache_count)
+    conn.logoff
+  end
+
+  def test_cached_define_plan
+    sql = "SELECT CAST(10 AS NUMBER(10)) num, CAST('abc' AS VARCHAR2(10)) str FROM DUAL"
+    cursor = @conn.exec(sql)
+    assert_equal([10, 'abc'], cursor.fetch)
+    cursor.close
+    # The second cursor uses the cached define plan.
+    cursor = @conn.exec(sql)
+    assert_equal([10, 'abc'], cursor.fetch)
+    assert_equal(['NUM', 'STR'], cursor.get_col_names)
+    assert_equal(:number, cursor.column_metadata[0].data_type)
+    cursor.close
+    # Any change of the mapping invalidates cached define plans.
+    mapping = OCI8::BindType::Mapping
+    oldval = mapping[:number]
+    begin
+      mapping[:number] = OCI8::BindType::OraNumber
+      assert_kind_of(OraNumber, @conn.select_one(sql)[0])
+      mapping.store(:number, OCI8::BindType::Float)
+      assert_kind_of(Float, @conn.select_one(sql)[0])
+      mapping.update(:number => OCI8::BindType::OraNumber)
+      assert_kind_of(OraNumber, @conn.select_one(sql)[0])
+      mapping.delete(:number)
+      assert_raises(RuntimeError) do
+        @conn.select_one(sql)
+      end
+    ensure
+      mapping[:number] = oldval
+    end
+    assert_equal([10, 'abc'], @conn.select_one(sql))
+  end
 end # TestOCI8
@@ -791,4 +791,39 @@ EOS
       conn.logoff
     end
   end
+
+  # Compare the direct conversions from OCINumber to Integer and
+  # Float with the conversions via strings.
+  def test_direct_conversion
+    orig = OCI8.properties[:float_conversion_type]
+    OCI8.properties[:float_conversion_type] = :ruby
+    rand = Random.new(20241018)
+    values = LARGE_RANGE_VALUES + [
+      "9007199254740992", # 2^53
+      "9007199254740993", # 2^53 + 1
+      "-9007199254740993",
+      "10000000000000000000000", # 1e22
+      "100000000000000000000000", # 1e23
+      "0.0000000000000000000001", # 1e-22
+      "0.00000000000000000000001", # 1e-23
+      "0.1",
+      "0.3",
+      "-0.7",
+    ]
+    20000.times do
+      digits = (1 + rand.rand(9)).to_s + (1...(1 + rand.rand(38))).collect { rand.rand(10).to_s }.join
+      point = rand.rand(digits.length + 1)
+      str = point == 0 ? digits : digits[0, point] + '.' + digits[point..-1]
+      str = '-' + str if rand.rand(2) == 0
+      values << str
+    end
+    values.each do |val|
+      onum = OraNumber.new(val)
+      str = onum.to_s
+      assert_equal(str.to_i, onum.to_i, val)
+      assert_equal(str.to_f, onum.to_f, val)
+    end
+  ensure
+    OCI8.properties[:float_conversion_type] = orig
+  end
 end
@@ -0,0 +1,81 @@
+require 'oci8'
+require File.dirname(__FILE__) + '/config'
+
+class TestPool < Minitest::Test
+
+  def test_checkout_and_checkin
+    pool = OCI8::Pool.new(2, $dbuser, $dbpass, $dbname, :timeout => 0.5)
+    conn1 = pool.checkout
+    conn2 = pool.checkout
+    assert_equal(2, pool.size)
+    assert_equal(2, pool.busy_count)
+    assert_raises(OCI8::Pool::TimeoutError) do
+      pool.checkout
+    end
+
+    thr = Thread.new { pool.checkout(10) }
+    sleep(0.1)
+    pool.checkin(conn1)
+    conn3 = thr.value
+    assert_same(conn1, conn3)
+
+    pool.checkin(conn2)
+    pool.checkin(conn3)
+    assert_equal(2, pool.idle_count)
+    assert_equal(0, pool.busy_count)
+
+    # checked in twice
+    assert_raises(ArgumentError) do
+      pool.checkin(conn3)
+    end
+    # not checked out from the pool
+    conn4 = OCI8.new($dbuser, $dbpass, $dbname)
+    assert_raises(ArgumentError) do
+      pool.checkin(conn4)
+    end
+    conn4.logoff
+    assert_equal(2, pool.idle_count)
+  ensure
+    pool.close if pool
+  end
+
+  def test_with_connection
+    pool = OCI8::Pool.new(3, $dbuser, $dbpass, $dbname)
+    threads = (1..6).map do |i|
+      Thread.new do
+        pool.with_connection do |conn|
+          conn.select_one('SELECT :1 FROM DUAL', i)[0]
+        end
+      end
+    end
+    assert_equal((1..6).to_a, threads.map(&:value))
+    assert_operator(pool.size, :<=, 3)
+  ensure
+    pool.close if pool
+  end
+
+  def test_ping_idle_connection
+    pool = OCI8::Pool.new(1, $dbuser, $dbpass, $dbname, :ping_interval => 0)
+    conn = pool.checkout
+    pool.checkin(conn)
+    # The idle connection is disconnected.
+    conn.logoff
+    conn2 = pool.checkout
+    refute_same(conn, conn2)
+    assert_equal([1], conn2.select_one('SELECT 1 FROM DUAL'))
+    pool.checkin(conn2)
+  ensure
+    pool.close if pool
+  end
+
+  def test_close
+    pool = OCI8::Pool.new(2, $dbuser, $dbpass, $dbname)
+    conn = pool.checkout
+    pool.close
+    assert_raises(RuntimeError) do
+      pool.checkout
+    end
+    pool.checkin(conn)
+    assert_equal(0, pool.size)
+  end
+end
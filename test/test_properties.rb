@@ -14,4 +14,30 @@ class TestProperties < Minitest::Test
     rescue NotImplementedError
     end
   end
+
+  def test_fetch_buffer_size
+    oldval = OCI8.properties[:fetch_buffer_size]
+    begin
+      OCI8.properties[:fetch_buffer_size] = 65536
+      assert_equal(65536, OCI8.properties[:fetch_buffer_size])
+      assert_raises(ArgumentError) do
+        OCI8.properties[:fetch_buffer_size] = 0
+      end
+    ensure
+      OCI8.properties[:fetch_buffer_size] = oldval
+    end
+  end
+
+  def test_cursor_cache_size
+    oldval = OCI8.properties[:cursor_cache_size]
+    begin
+      OCI8.properties[:cursor_cache_size] = '10'
+      assert_equal(10, OCI8.properties[:cursor_cache_size])
+      assert_raises(ArgumentError) do
+        OCI8.properties[:cursor_cache_size] = -1
+      end
+    ensure
+      OCI8.properties[:cursor_cache_size] = oldval
+    end
+  end
 end
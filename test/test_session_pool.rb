@@ -0,0 +1,96 @@
+require 'oci8'
+require File.dirname(__FILE__) + '/config'
+
+class TestSessionPool < Minitest::Test
+
+  def create_pool(min, max, incr)
+    OCI8::SessionPool.new(min, max, incr, $dbuser, $dbpass, $dbname)
+  rescue OCIError
+    raise if $!.code != 12516 && $!.code != 12520
+    sleep(5)
+    OCI8::SessionPool.new(min, max, incr, $dbuser, $dbpass, $dbname)
+  end
+
+  def test_connect
+    pool = create_pool(1, 5, 2)
+    assert_equal(1, pool.min)
+    assert_equal(5, pool.max)
+    assert_equal(2, pool.incr)
+    pool.reinitialize(2, 6, 3)
+    assert_equal(2, pool.min)
+    assert_equal(6, pool.max)
+    assert_equal(3, pool.incr)
+    pool.destroy
+  end
+
+  def test_get_and_release
+    pool = create_pool(1, 3, 1)
+    assert_equal(1, pool.open_count)
+    assert_equal(0, pool.busy_count)
+
+    conns = []
+    3.times do
+      conns << OCI8.new(nil, nil, pool)
+    end
+    assert_equal(3, pool.open_count)
+    assert_equal(3, pool.busy_count)
+    conns.each do |conn|
+      assert_equal([1], conn.select_one('SELECT 1 FROM DUAL'))
+    end
+    conns.each(&:logoff)
+    assert_equal(3, pool.open_count)
+    assert_equal(0, pool.busy_count)
+
+    # a session in the pool is reused.
+    conn = OCI8.new(nil, nil, pool)
+    assert_equal(3, pool.open_count)
+    conn.logoff
+    pool.destroy
+  end
+
+  def test_session_tag
+    pool = create_pool(1, 2, 1)
+    tag = 'NLS_DATE_FORMAT=YYYY-MM-DD'
+
+    conn = OCI8.new(nil, nil, pool, tag)
+    assert_equal(false, conn.session_tag_found?)
+    conn.exec("ALTER SESSION SET NLS_DATE_FORMAT = 'YYYY-MM-DD'")
+    conn.session_tag = tag
+    assert_equal(tag, conn.session_tag)
+    sid = conn.select_one("SELECT SYS_CONTEXT('USERENV', 'SID') FROM DUAL")[0]
+    conn.logoff
+
+    conn = OCI8.new(nil, nil, pool, tag)
+    assert_equal(true, conn.session_tag_found?)
+    assert_equal(tag, conn.session_tag)
+    assert_equal(sid, conn.select_one("SELECT SYS_CONTEXT('USERENV', 'SID') FROM DUAL")[0])
+    assert_equal('2000-01-02', conn.select_one("SELECT TO_CHAR(TO_DATE('2000-01-02', 'YYYY-MM-DD')) FROM DUAL")[0])
+    conn.logoff
+    pool.destroy
+  end
+
+  def test_purity
+    pool = create_pool(0, 1, 1)
+    assert_equal(:default, pool.purity)
+    pool.purity = :self
+    assert_equal(:self, pool.purity)
+    assert_raises(ArgumentError) do
+      pool.purity = :invalid
+    end
+    pool.destroy
+  end
+
+  def test_warm_up
+    pool = create_pool(0, 4, 1)
+    assert_equal(0, pool.open_count)
+    assert_operator(pool.warm_up(3), :>=, 3)
+    assert_operator(pool.open_count, :>=, 3)
+    assert_equal(0, pool.busy_count)
+    # limited to the maximum number of sessions
+    assert_equal(4, pool.warm_up(10))
+    conn = OCI8.new(nil, nil, pool)
+    assert_equal([1], conn.select_one('select 1 from dual'))
+    conn.logoff
+    pool.destroy
+  end
+end